@@ -0,0 +1,98 @@
+// Search ranking benchmark: FuzzyMatcher over a resident history of
+// previews, per instruction set, plus the full HistoryModel::query path
+// Build: cmake -DHYPRCLIPX_BUILD_BENCH=ON -B build && cmake --build build
+// Run:   build/bench_fuzzy [iterations]
+
+#include "hyprclipx/EntryStore.hpp"
+#include "hyprclipx/FuzzyMatcher.hpp"
+#include "hyprclipx/HistoryModel.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace hyprclipx;
+
+// Previews shaped like clipman-daemon's: mostly one-line ASCII, some prose
+// in other scripts, the odd image
+static std::vector<ClipboardEntry> makeEntries(int count) {
+    static const char* PREVIEWS[] = {
+        "kubectl get pods -n kube-system -o wide --sort-by=.metadata.creationTimestamp",
+        "const auto it = std::find_if(v.begin(), v.end(), [](auto& x) { return x.ok; });",
+        "He said \"hello\" then left",
+        "https://example.org/some/very/long/path?with=query&and=more#fragment",
+        "Die Größe der Straße wurde überprüft, Ärger blieb aus",
+        "SELECT id, created_at FROM items WHERE favorite = 1 ORDER BY created_at DESC",
+        "Привет, как дела? Встреча перенесена на пятницу",
+        "git rebase --onto origin/main feature~3 feature",
+        "ok",
+        "[Image 42KB]",
+    };
+    std::vector<ClipboardEntry> items;
+    items.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; i++) {
+        char uuid[40];
+        snprintf(uuid, sizeof(uuid), "%08x-1b2c-4d3e-8f40-%012x", i * 2654435761u, i);
+        ClipboardEntry e;
+        e.uuid = uuid;
+        e.type = i % 10 == 9 ? "image" : "text";
+        // Vary the text so runs of equal previews don't flatter the caches
+        e.preview = std::string(PREVIEWS[i % 10]) + " #" + std::to_string(i);
+        e.createdAt = "2025-11-03 14:22:51";
+        items.push_back(std::move(e));
+    }
+    return items;
+}
+
+template <typename Fn>
+static double millisPerRun(int iterations, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) fn();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+    const int entries = 10000;
+
+    std::vector<ClipboardEntry> source = makeEntries(entries);
+    EntryStore::Builder builder;
+    for (const auto& e : source) builder.append(e);
+    HistoryModel model;
+    model.reset(builder.build(), 1);
+
+    const char* patterns[] = {"k", "kgp", "find_if", "exmplfrag", "zzzz", "größe", "ПРИВЕТ", "пятн"};
+    const char* isas[] = {"scalar", "sse4.2", "avx2"};
+    const char* detected = FuzzyMatcher::isa();
+
+    printf("%d previews, best ISA: %s, ms per ranking of all previews\n", entries, detected);
+    printf("  %-10s %8s", "pattern", "matches");
+    for (const char* isa : isas) printf(" %9s", isa);
+    printf(" %12s\n", "query(50)");
+
+    for (const char* pattern : patterns) {
+        FuzzyMatcher matcher(pattern);
+        int matches = 0;
+        for (const auto& e : source) matches += matcher.match(e.preview).has_value();
+        printf("  %-10s %8d", pattern, matches);
+
+        for (const char* isa : isas) {
+            if (!FuzzyMatcher::setIsa(isa)) { printf(" %9s", "-"); continue; }
+            long sink = 0;
+            double ms = millisPerRun(iterations, [&] {
+                for (const auto& e : source)
+                    if (auto s = matcher.match(e.preview)) sink += *s;
+            });
+            printf(" %9.3f", ms);
+            if (sink == 42) printf("!");  // keep the loop
+        }
+
+        // What a keystroke costs: match, rank, materialize the first page
+        FuzzyMatcher::setIsa(detected);
+        double ms = millisPerRun(iterations, [&] { (void)model.query("all", pattern, 50); });
+        printf(" %12.3f\n", ms);
+    }
+    return 0;
+}
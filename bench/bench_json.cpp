@@ -0,0 +1,81 @@
+// Throughput benchmark for the list-reply parser (JsonParser.cpp)
+// Build: cmake -DHYPRCLIPX_BUILD_BENCH=ON -B build && cmake --build build
+// Run:   build/bench_json [iterations]
+
+#include "hyprclipx/JsonParser.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace hyprclipx;
+
+// Reply shaped like clipman-daemon's "list" output (same keys, same order),
+// with a mix of plain, escaped and non-ASCII previews
+static std::string makePayload(int entries) {
+    static const char* PREVIEWS[] = {
+        "kubectl get pods -n kube-system -o wide --sort-by=.metadata.creationTimestamp",
+        "const auto it = std::find_if(v.begin(), v.end(), [](auto& x) { return x.ok; });",
+        "He said \\\"hello\\\" \\\\ then left\\tthe room",
+        "Gr\\u00fc\\u00dfe aus M\\u00fcnchen \\ud83d\\ude00 \\u2014 na?",
+        "https://example.org/some/very/long/path?with=query&and=more#fragment",
+    };
+    std::string json = "{\"id\": 7, \"status\": \"ok\", \"more\": false, \"data\": [";
+    for (int i = 0; i < entries; i++) {
+        char uuid[40];
+        snprintf(uuid, sizeof(uuid), "%08x-1b2c-4d3e-8f40-%012x", i * 2654435761u, i);
+        bool image = i % 11 == 0;
+        if (i) json += ", ";
+        json += "{\"id\": " + std::to_string(i + 1) + ", \"uuid\": \"" + uuid + "\", ";
+        json += std::string("\"content_type\": \"") + (image ? "image" : "text") + "\", ";
+        json += std::string("\"preview\": \"") + (image ? "[Image 42KB]" : PREVIEWS[i % 5]) + "\", ";
+        json += "\"content_hash\": \"9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08\", ";
+        json += std::string("\"file_path\": \"") + (image ? "images/" : "text/") + uuid + ".txt\", ";
+        if (image)
+            json += std::string("\"thumb_path\": \"thumbs/") + uuid + ".png\", ";
+        else
+            json += "\"thumb_path\": null, ";
+        json += "\"created_at\": \"2025-11-03 14:22:51\", \"is_favorite\": " +
+                std::string(i % 7 == 0 ? "1" : "0") + ", ";
+        json += "\"byte_size\": 1234, \"line_count\": 1, ";
+        if (image)
+            json += std::string("\"thumb\": \"/home/user/.local/share/clipman/thumbs/") + uuid + ".png\", ";
+        json += std::string("\"favorite\": ") + (i % 7 == 0 ? "true" : "false") + ", ";
+        json += std::string("\"type\": \"") + (image ? "image" : "text") + "\"}";
+    }
+    json += "]}";
+    return json;
+}
+
+static void run(int entries, int iterations) {
+    std::string payload = makePayload(entries);
+
+    std::vector<ClipboardEntry> items;
+    items.reserve(static_cast<size_t>(entries));
+    if (!parseListReply(payload, items) || static_cast<int>(items.size()) != entries) {
+        fprintf(stderr, "parse failed for %d entries\n", entries);
+        std::exit(1);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t parsed = 0;
+    for (int it = 0; it < iterations; it++) {
+        items.clear();
+        parseListReply(payload, items);
+        parsed += items.size();
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double mb = static_cast<double>(payload.size()) * iterations / (1024.0 * 1024.0);
+    printf("%6d entries  %8.1f KB  %8.1f us/parse  %8.1f MB/s  %6.2f M entries/s\n",
+           entries, static_cast<double>(payload.size()) / 1024.0,
+           secs * 1e6 / iterations, mb / secs, static_cast<double>(parsed) / secs / 1e6);
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+    run(700, iterations);
+    run(10000, std::max(1, iterations / 10));
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Memory / allocation benchmark for the history model's EntryStore
+// (EntryStore.cpp) against a plain std::vector<ClipboardEntry>
+// Build: cmake -DHYPRCLIPX_BUILD_BENCH=ON -B build && cmake --build build
+// Run:   build/bench_store [iterations]
+
+#include "hyprclipx/EntryStore.hpp"
+#include "hyprclipx/HistoryModel.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace hyprclipx;
+
+// Every heap allocation goes through here, so a phase can be measured by
+// the difference of the counters before and after it
+static size_t g_allocs = 0;
+static size_t g_bytes = 0;
+
+void* operator new(size_t size) {
+    g_allocs++;
+    g_bytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+struct Usage {
+    size_t allocs, bytes;
+    static Usage now() { return {g_allocs, g_bytes}; }
+    Usage since() const { return {g_allocs - allocs, g_bytes - bytes}; }
+};
+
+// Entries shaped like clipman-daemon's "list" output
+static std::vector<ClipboardEntry> makeEntries(int count) {
+    static const char* PREVIEWS[] = {
+        "kubectl get pods -n kube-system -o wide --sort-by=.metadata.creationTimestamp",
+        "const auto it = std::find_if(v.begin(), v.end(), [](auto& x) { return x.ok; });",
+        "He said \"hello\" then left",
+        "https://example.org/some/very/long/path?with=query&and=more#fragment",
+        "ok",
+    };
+    std::vector<ClipboardEntry> items;
+    items.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; i++) {
+        char uuid[40];
+        snprintf(uuid, sizeof(uuid), "%08x-1b2c-4d3e-8f40-%012x", i * 2654435761u, i);
+        bool image = i % 11 == 0;
+        ClipboardEntry e;
+        e.uuid = uuid;
+        e.type = image ? "image" : "text";
+        e.preview = image ? "[Image 42KB]" : PREVIEWS[i % 5];
+        if (image) e.thumb = std::string("/home/user/.local/share/clipman/thumbs/") + uuid + ".png";
+        e.favorite = i % 7 == 0;
+        e.createdAt = "2025-11-03 14:22:51";
+        items.push_back(std::move(e));
+    }
+    return items;
+}
+
+static void run(int entries, int iterations) {
+    std::vector<ClipboardEntry> source = makeEntries(entries);
+    HistoryChange insert;
+    insert.item = source[static_cast<size_t>(entries / 2)];
+    insert.item.uuid = "0badc0de-1b2c-4d3e-8f40-000000000000";
+    std::vector<HistoryChange> changes{insert};
+
+    // Resident size: a copy of each representation
+    Usage before = Usage::now();
+    std::vector<ClipboardEntry> vec = source;
+    Usage vecUse = before.since();
+
+    before = Usage::now();
+    EntryStore::Builder builder;
+    for (const auto& e : source) builder.append(e);
+    std::shared_ptr<const EntryStore> store = builder.build();
+    Usage storeUse = before.since();
+
+    // Refresh after one insert: fresh vector vs next store
+    before = Usage::now();
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        std::vector<ClipboardEntry> next = vec;
+        applyChanges(next, changes);
+    }
+    double vecSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Usage vecRefresh = before.since();
+
+    before = Usage::now();
+    start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        std::shared_ptr<const EntryStore> next = store->withChanges(changes);
+    }
+    double storeSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Usage storeRefresh = before.since();
+
+    printf("%6d entries\n", entries);
+    printf("  vector<ClipboardEntry>  %7.1f B/entry  %6zu allocs  refresh: %7zu allocs %8.1f us\n",
+           static_cast<double>(vecUse.bytes) / entries, vecUse.allocs,
+           vecRefresh.allocs / iterations, vecSecs * 1e6 / iterations);
+    printf("  EntryStore              %7.1f B/entry  %6zu allocs  refresh: %7zu allocs %8.1f us\n",
+           static_cast<double>(store->memoryUsage()) / entries, storeUse.allocs,
+           storeRefresh.allocs / iterations, storeSecs * 1e6 / iterations);
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 50;
+    run(10000, iterations);
+    run(50000, std::max(1, iterations / 5));
+    return 0;
+}
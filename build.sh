@@ -25,12 +25,14 @@ case "$1" in
         cp helpers/clipman-daemon.py "$HOME/.local/bin/"
         cp helpers/clipman-client.py "$HOME/.local/bin/"
         cp helpers/get-caret-position.py "$HOME/.local/bin/"
+        cp helpers/caret-daemon.py "$HOME/.local/bin/"
         mkdir -p "$HOME/.config/hyprclipx"
         mkdir -p "$HOME/.config/systemd/user"
         cp helpers/clipman.service "$HOME/.config/systemd/user/"
+        cp helpers/hyprclipx-caret.service "$HOME/.config/systemd/user/"
         systemctl --user daemon-reload
-        systemctl --user enable clipman.service
-        echo "Installed UI, daemon, client and service to ~/.local/bin/"
+        systemctl --user enable clipman.service hyprclipx-caret.service
+        echo "Installed UI, daemons, client and services to ~/.local/bin/"
         echo "Use 'hyprpm add' + 'hyprpm enable hyprclipx' to load the plugin"
         ;;
     *)
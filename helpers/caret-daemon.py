@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+"""
+Caret daemon - resident text caret position service for HyprClipX
+
+Keeps one AT-SPI connection open and follows the focused text object through
+focus and caret-moved events, so a lookup is one call to that object instead
+of starting Python, importing gi, connecting to the bus and walking every
+application's tree (get-caret-position.py, still used when this isn't running).
+
+Protocol (Unix socket, one JSON object per line, one reply per request):
+    -> {"pid": 1234}                        pid of the focused window, 0 = any
+    <- {"x": 812, "y": 440, "pid": 1234}    screen coordinates of the caret
+    <- {"x": -1, "y": -1}                   no caret known for that window
+"""
+
+import os
+import sys
+import json
+import socket
+import signal
+
+import gi
+gi.require_version('Atspi', '2.0')
+from gi.repository import Atspi, GLib
+
+SOCKET_PATH = "/tmp/hyprclipx-caret.sock"
+# Bound on every AT-SPI call into an application (a hung app must not stall
+# the service)
+ATSPI_TIMEOUT_MS = 250
+# Depth limit when a lookup has to search an application's tree
+MAX_DEPTH = 15
+MAX_REQUEST = 4096
+
+
+def caret_rect(obj, offset=None):
+    """Screen position of the caret in `obj`, or None"""
+    text = obj.get_text()
+    if not text:
+        return None
+    if offset is None:
+        offset = text.get_caret_offset()
+    if offset < 0:
+        return None
+    rect = text.get_character_extents(offset, Atspi.CoordType.SCREEN)
+    if rect and rect.x >= 0 and rect.y >= 0 and (rect.width or rect.height):
+        return rect.x, rect.y
+    # Caret past the last character: toolkits report an empty box there,
+    # take the right edge of the character before it
+    if offset > 0:
+        rect = text.get_character_extents(offset - 1, Atspi.CoordType.SCREEN)
+        if rect and rect.x >= 0 and rect.y >= 0:
+            return rect.x + rect.width, rect.y
+    return None
+
+
+class CaretTracker:
+    """Last known caret, kept current from AT-SPI events"""
+
+    def __init__(self):
+        self.obj = None   # focused text object
+        self.pid = 0      # its application's pid
+        self.pos = None   # (x, y) at the last event
+        # pids (0 = any) whose tree was searched without finding a caret; not
+        # searched again until that application sends an event
+        self.missed = set()
+
+        self._listener = Atspi.EventListener.new(self._on_event)
+        for event in ("object:text-caret-moved", "object:state-changed:focused"):
+            self._listener.register(event)
+
+    def _remember(self, obj, offset=None):
+        """True if `obj` has a caret, now the one known"""
+        try:
+            pos = caret_rect(obj, offset)
+            if pos is None:
+                return False
+            self.obj, self.pid, self.pos = obj, obj.get_process_id(), pos
+            return True
+        except GLib.Error:
+            return False
+
+    def _forget(self):
+        self.obj, self.pid, self.pos = None, 0, None
+
+    def _on_event(self, event):
+        obj = event.source
+        try:
+            self.missed.discard(obj.get_process_id())
+        except GLib.Error:
+            pass
+        self.missed.discard(0)
+        if event.type == "object:text-caret-moved":
+            self._remember(obj, event.detail1)
+        elif event.detail1:
+            self._remember(obj)
+        elif obj == self.obj:
+            # Focus left the text object we knew about
+            self._forget()
+
+    def _search(self, pid):
+        """No event seen for this window yet (e.g. just started): search the
+        application's tree, and remember what is found. True if found"""
+        def find(obj, depth):
+            if depth > MAX_DEPTH:
+                return None
+            try:
+                state = obj.get_state_set()
+                if state and state.contains(Atspi.StateType.FOCUSED) and obj.get_text():
+                    return obj
+                for i in range(obj.get_child_count()):
+                    child = obj.get_child_at_index(i)
+                    found = child and find(child, depth + 1)
+                    if found:
+                        return found
+            except GLib.Error:
+                pass
+            return None
+
+        desktop = Atspi.get_desktop(0)
+        for i in range(desktop.get_child_count()):
+            app = desktop.get_child_at_index(i)
+            try:
+                if not app or (pid and app.get_process_id() != pid):
+                    continue
+            except GLib.Error:
+                continue
+            found = find(app, 0)
+            if found and self._remember(found):
+                return True
+        return False
+
+    def lookup(self, pid):
+        known = self.obj is not None and (not pid or self.pid == pid)
+        # The caret's screen position changes with its window, which sends
+        # no event when it is moved: read it again from the focused object
+        # (one call) rather than answer with where it was at the last event
+        if known and not self._remember(self.obj):
+            self._forget()
+            known = False
+        if not known and pid not in self.missed:
+            known = self._search(pid) and (not pid or self.pid == pid)
+            if not known:
+                self.missed.add(pid)
+        if not known:
+            return {"x": -1, "y": -1}
+        return {"x": self.pos[0], "y": self.pos[1], "pid": self.pid}
+
+
+class CaretServer:
+    """Line-based request / reply socket on the GLib main loop"""
+
+    def __init__(self, path, tracker):
+        self.path = path
+        self.tracker = tracker
+        self.buffers = {}
+
+        if os.path.exists(path):
+            os.unlink(path)
+        self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.sock.bind(path)
+        self.sock.listen(8)
+        self.sock.setblocking(False)
+        GLib.io_add_watch(self.sock.fileno(), GLib.PRIORITY_DEFAULT, GLib.IO_IN, self._on_accept)
+
+    def _on_accept(self, fd, cond):
+        try:
+            conn, _ = self.sock.accept()
+        except BlockingIOError:
+            return True
+        conn.setblocking(False)
+        self.buffers[conn.fileno()] = (conn, b"")
+        GLib.io_add_watch(conn.fileno(), GLib.PRIORITY_DEFAULT,
+                          GLib.IO_IN | GLib.IO_HUP | GLib.IO_ERR, self._on_readable)
+        return True
+
+    def _close(self, fd):
+        conn, _ = self.buffers.pop(fd, (None, b""))
+        if conn:
+            conn.close()
+        return False
+
+    def _on_readable(self, fd, cond):
+        conn, buf = self.buffers.get(fd, (None, b""))
+        if conn is None:
+            return False
+        try:
+            data = conn.recv(4096)
+        except BlockingIOError:
+            return True
+        except OSError:
+            return self._close(fd)
+        if not data:
+            return self._close(fd)
+
+        buf += data
+        while b"\n" in buf:
+            line, buf = buf.split(b"\n", 1)
+            try:
+                request = json.loads(line)
+                reply = self.tracker.lookup(int(request.get("pid", 0)))
+            except (ValueError, TypeError, AttributeError):
+                reply = {"error": "bad request"}
+            try:
+                conn.sendall(json.dumps(reply).encode() + b"\n")
+            except OSError:
+                return self._close(fd)
+        if len(buf) > MAX_REQUEST:
+            return self._close(fd)
+        self.buffers[fd] = (conn, buf)
+        return True
+
+    def close(self):
+        for fd in list(self.buffers):
+            self._close(fd)
+        self.sock.close()
+        if os.path.exists(self.path):
+            os.unlink(self.path)
+
+
+def main():
+    path = sys.argv[1] if len(sys.argv) > 1 else SOCKET_PATH
+
+    Atspi.init()
+    Atspi.set_timeout(ATSPI_TIMEOUT_MS, -1)
+    tracker = CaretTracker()
+    server = CaretServer(path, tracker)
+
+    loop = GLib.MainLoop()
+    for sig in (signal.SIGINT, signal.SIGTERM):
+        GLib.unix_signal_add(GLib.PRIORITY_DEFAULT, sig, loop.quit)
+
+    print(f"Caret daemon listening on {path}", flush=True)
+    try:
+        loop.run()
+    finally:
+        server.close()
+
+
+if __name__ == "__main__":
+    main()
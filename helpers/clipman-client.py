@@ -5,9 +5,33 @@ Clipman Client - IPC client for communicating with clipman-daemon
 
 import socket
 import json
+import struct
 import sys
 
 SOCKET_PATH = "/tmp/clipman.sock"
+# Framed protocol (see clipman-daemon.py): preamble, then 4-byte length + JSON
+MUX_PREAMBLE = b"HCX2\n"
+
+
+def _recv_exact(sock, size):
+    """Read exactly `size` bytes, however the kernel splits them"""
+    chunks = []
+    while size > 0:
+        chunk = sock.recv(min(size, 65536))
+        if not chunk:
+            raise ConnectionError("Daemon closed the connection")
+        chunks.append(chunk)
+        size -= len(chunk)
+    return b"".join(chunks)
+
+
+def _recv_frame(sock):
+    """Next reply frame; unsolicited events (id 0) are skipped"""
+    while True:
+        (length,) = struct.unpack(">I", _recv_exact(sock, 4))
+        frame = json.loads(_recv_exact(sock, length).decode('utf-8'))
+        if frame.get("id") != 0:
+            return frame
 
 
 def send_command(cmd, args=None):
@@ -16,10 +40,20 @@ def send_command(cmd, args=None):
         with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:
             sock.settimeout(5.0)
             sock.connect(SOCKET_PATH)
-            request = {"cmd": cmd, "args": args or {}}
-            sock.send(json.dumps(request).encode('utf-8'))
-            response = sock.recv(65536)
-            return json.loads(response.decode('utf-8'))
+            request = json.dumps({"id": 1, "cmd": cmd, "args": args or {}}).encode('utf-8')
+            sock.sendall(MUX_PREAMBLE + struct.pack(">I", len(request)) + request)
+
+            # List replies arrive in chunks; stitch "data" back together
+            response = _recv_frame(sock)
+            data = response.get("data")
+            while response.get("more"):
+                response = _recv_frame(sock)
+                data.extend(response.get("data", []))
+            response.pop("id", None)
+            response.pop("more", None)
+            if data is not None:
+                response["data"] = data
+            return response
     except FileNotFoundError:
         return {"status": "error", "error": "Daemon not running (socket not found)"}
     except ConnectionRefusedError:
@@ -39,9 +73,10 @@ Usage:
 Commands:
     list [args]     List clipboard items
                     args: {"filter": "all|text|image|favorites", "search": "query", "limit": 50}
+                    Pass a reply's "next_cursor" as "after" for the following page
 
-    paste <args>    Paste item to clipboard
-                    args: {"uuid": "item-uuid"}
+    paste <args>    Paste item to clipboard (several text items: "uuids")
+                    args: {"uuid": "item-uuid"} or {"uuids": ["a", "b"]}
 
     favorite <args> Toggle favorite status
                     args: {"uuid": "item-uuid"}
@@ -49,6 +84,14 @@ Commands:
     delete <args>   Delete item
                     args: {"uuid": "item-uuid"}
 
+    favorite_many <args>
+                    Set (or toggle, without "favorite") favorite on several items
+                    args: {"uuids": ["a", "b"], "favorite": true}
+
+    delete_many <args>
+                    Delete several items in one transaction
+                    args: {"uuids": ["a", "b"]}
+
     clear           Clear all non-favorite items
 
     ping            Check if daemon is running
@@ -15,7 +15,11 @@ import threading
 import uuid
 import time
 import signal
+import struct
 import re
+import queue
+import zlib
+from collections import deque
 from pathlib import Path
 from datetime import datetime
 
@@ -25,19 +29,74 @@ CONFIG = {
     "max_image_size_mb": 10,
     "preview_length": 100,
     "socket_path": "/tmp/clipman.sock",
+    # Published by the hyprclipx plugin (SelectionNotifier); polling without it
+    "selection_socket": "/tmp/hyprclipx-selection.sock",
     "data_dir": Path.home() / ".local/share/clipman",
     "sensitive_ttl_seconds": 60,
 }
 
+# Sent by persistent clients right after connect (see IPCServer._handle_mux_client)
+MUX_PREAMBLE = b"HCX2\n"
+# Framed mode: 4-byte big-endian length + JSON payload
+MAX_FRAME_SIZE = 16 * 1024 * 1024
+# List replies are streamed in chunks of this many items
+LIST_CHUNK_SIZE = 64
+# Mutations kept for "subscribe since N" deltas; older clients get a snapshot
+CHANGELOG_SIZE = 1024
+# Blob store: payloads up to LARGE_BLOB are packed into segment files,
+# which are sealed at SEGMENT_SIZE
+SEGMENT_SIZE = 32 * 1024 * 1024
+LARGE_BLOB = 1024 * 1024
+# Search index: text indexed per item (longer pastes match on their start)
+SEARCH_TEXT_LIMIT = 1024 * 1024
+# Paste replies wait for the plugin to report the new selection, at most
+# this long; polling (no events), a fixed settle time instead
+PASTE_CONFIRM_TIMEOUT = 0.5
+PASTE_SETTLE = 0.2
+
+
+def content_key(data):
+    """Content address of a payload: BLAKE2b-128, hex"""
+    return hashlib.blake2b(data, digest_size=16).hexdigest()
+
+
+def encode_frame(payload):
+    data = json.dumps(payload).encode('utf-8')
+    return struct.pack(">I", len(data)) + data
+
+
+def public_item(row):
+    """Item as sent to clients: full thumb path, normalized field names"""
+    item = dict(row)
+    if item.get("thumb_path"):
+        item["thumb"] = str(CONFIG["data_dir"] / item["thumb_path"])
+    item["favorite"] = bool(item.get("is_favorite"))
+    item["type"] = item.get("content_type")
+    return item
+
 
 class ClipmanDB:
     """SQLite database handler for clipboard metadata"""
 
-    def __init__(self, db_path):
+    def __init__(self, db_path, store=None):
         self.db_path = db_path
+        # ContentStore holding the payloads; without one, paths are plain files
+        self.store = store
         self.lock = threading.Lock()
         self.conn = sqlite3.connect(str(db_path), check_same_thread=False)
         self.conn.row_factory = sqlite3.Row
+        # WAL without a sync per commit: a power cut may lose the last copies,
+        # never corrupt the history
+        self.conn.execute("PRAGMA journal_mode=WAL")
+        self.conn.execute("PRAGMA synchronous=NORMAL")
+        # History generation: bumped on every mutation so clients can tell
+        # whether a cached list is still current. Seeded from the clock so
+        # values are never reused across daemon restarts.
+        self.generation = time.time_ns() // 1000
+        # (generation, changes) of recent mutations, oldest first
+        self.changelog = deque(maxlen=CHANGELOG_SIZE)
+        # Called as listener(generation, changes) with self.lock held
+        self.listeners = []
         self._init_db()
 
     def _init_db(self):
@@ -57,12 +116,134 @@ class ClipmanDB:
             );
             CREATE INDEX IF NOT EXISTS idx_hash ON items(content_hash);
             CREATE INDEX IF NOT EXISTS idx_created ON items(created_at DESC);
+            CREATE INDEX IF NOT EXISTS idx_created_id ON items(created_at DESC, id DESC);
             CREATE INDEX IF NOT EXISTS idx_favorite ON items(is_favorite);
         ''')
+        # Full-text search: trigram index over each item's whole text, kept
+        # in step with items (rowid = items.id). LIKE on it is answered from
+        # the index for patterns of 3+ characters, candidates verified
+        # against the text. Needs SQLite 3.34+; older ones search previews.
+        try:
+            self.conn.executescript('''
+                CREATE VIRTUAL TABLE IF NOT EXISTS items_fts
+                    USING fts5(body, tokenize='trigram');
+                CREATE TRIGGER IF NOT EXISTS items_fts_delete AFTER DELETE ON items
+                BEGIN
+                    DELETE FROM items_fts WHERE rowid = old.id;
+                END;
+            ''')
+            self.search_index = True
+        except sqlite3.OperationalError:
+            self.search_index = False
         self.conn.commit()
 
+    def _publish(self, changes):
+        """Record a mutation (caller holds self.lock): bump the generation,
+        log the changes and hand them to listeners in commit order.
+        Listeners run under the lock, so they must not block."""
+        self.generation += 1
+        self.changelog.append((self.generation, changes))
+        for listener in self.listeners:
+            try:
+                listener(self.generation, changes)
+            except Exception as e:
+                print(f"Change listener error: {e}", file=sys.stderr)
+
+    def _drop_files(self, paths):
+        """Release payloads / delete files of removed items"""
+        for path in paths:
+            if not path:
+                continue
+            if self.store:
+                self.store.release(path)
+                continue
+            full_path = CONFIG["data_dir"] / path
+            try:
+                full_path.unlink()
+            except OSError:
+                pass
+
+    def migrate_payloads(self):
+        """Move payloads still kept as one file per item into the store"""
+        if not self.store:
+            return
+        with self.lock:
+            rows = self.conn.execute(
+                "SELECT uuid, content_type, file_path FROM items "
+                "WHERE file_path NOT LIKE 'blob/%'"
+            ).fetchall()
+            for row in rows:
+                legacy = CONFIG["data_dir"] / row['file_path']
+                try:
+                    data = legacy.read_bytes()
+                except OSError:
+                    continue
+                file_path, content_hash = self.store.put(
+                    data, compress=row['content_type'] == "text")
+                self.conn.execute(
+                    "UPDATE items SET file_path = ?, content_hash = ? WHERE uuid = ?",
+                    (file_path, content_hash, row['uuid']))
+                self.conn.commit()
+                legacy.unlink(missing_ok=True)
+            if rows:
+                print(f"Moved {len(rows)} payload files into the blob store")
+
+    def build_search_index(self):
+        """Index items stored before the search index existed"""
+        if not self.search_index:
+            return
+        with self.lock:
+            rows = self.conn.execute(
+                "SELECT id, content_type, preview, file_path FROM items "
+                "WHERE id NOT IN (SELECT rowid FROM items_fts)"
+            ).fetchall()
+            for row in rows:
+                body = row['preview'] or ""
+                # Sensitive items keep only their masked preview searchable
+                if (row['content_type'] == "text" and self.store
+                        and not body.startswith("[sensitive]")):
+                    content = self.store.get_content(row['file_path'])
+                    if isinstance(content, bytes):
+                        content = content.decode('utf-8', errors='replace')
+                    body = content or body
+                self.conn.execute("INSERT INTO items_fts (rowid, body) VALUES (?, ?)",
+                                  (row['id'], body[:SEARCH_TEXT_LIMIT]))
+            self.conn.commit()
+            if rows:
+                print(f"Indexed {len(rows)} items for search")
+
+    def _item_row(self, item_uuid):
+        return self.conn.execute(
+            "SELECT * FROM items WHERE uuid = ?", (item_uuid,)
+        ).fetchone()
+
+    def _changes_since(self, since):
+        """Changes after generation `since` (caller holds self.lock), or
+        None when the changelog no longer reaches back that far"""
+        if since == self.generation:
+            return []
+        if since > self.generation or not self.changelog or self.changelog[0][0] > since + 1:
+            return None
+        return [c for gen, changes in self.changelog if gen > since for c in changes]
+
+    def sync(self, since, on_locked):
+        """Atomically run on_locked() and read what a client at generation
+        `since` has missed. Returns (generation, changes, items); items (the
+        whole history, newest first) only when changes is None."""
+        with self.lock:
+            on_locked()
+            changes = self._changes_since(since)
+            items = None
+            if changes is None:
+                rows = self.conn.execute(
+                    "SELECT * FROM items ORDER BY created_at DESC, id DESC"
+                ).fetchall()
+                items = [public_item(row) for row in rows]
+            return self.generation, changes, items
+
     def add_item(self, item_uuid, content_type, preview, content_hash,
-                 file_path, thumb_path, byte_size, line_count):
+                 file_path, thumb_path, byte_size, line_count, search_text=None):
+        """search_text: what search matches (default: the preview)"""
         with self.lock:
             # Check duplicate by hash
             existing = self.conn.execute(
@@ -76,21 +257,37 @@ class ClipmanDB:
                     (existing['uuid'],)
                 )
                 self.conn.commit()
-                return existing['uuid']
-
-            # Insert new item
-            self.conn.execute('''
-                INSERT INTO items (uuid, content_type, preview, content_hash,
-                                 file_path, thumb_path, byte_size, line_count)
-                VALUES (?, ?, ?, ?, ?, ?, ?, ?)
-            ''', (item_uuid, content_type, preview, content_hash,
-                  file_path, thumb_path, byte_size, line_count))
-            self.conn.commit()
-            self._cleanup()
-            return item_uuid
+                # The existing item already holds the payload
+                self._drop_files([file_path, thumb_path])
+                result = existing['uuid']
+                changes = [{"op": "update", "item": public_item(self._item_row(result))}]
+            else:
+                # Insert new item
+                self.conn.execute('''
+                    INSERT INTO items (uuid, content_type, preview, content_hash,
+                                     file_path, thumb_path, byte_size, line_count)
+                    VALUES (?, ?, ?, ?, ?, ?, ?, ?)
+                ''', (item_uuid, content_type, preview, content_hash,
+                      file_path, thumb_path, byte_size, line_count))
+                if self.search_index:
+                    body = preview if search_text is None else search_text
+                    self.conn.execute(
+                        "INSERT INTO items_fts (rowid, body) "
+                        "SELECT id, ? FROM items WHERE uuid = ?",
+                        ((body or "")[:SEARCH_TEXT_LIMIT], item_uuid))
+                self.conn.commit()
+                changes = [{"op": "insert", "item": public_item(self._item_row(item_uuid))}]
+                changes += [{"op": "delete", "uuid": u} for u in self._cleanup()]
+                result = item_uuid
+            self._publish(changes)
+        return result
 
     def get_items(self, filter_type="all", favorites_only=False,
-                  search="", limit=50):
+                  search="", limit=50, after=None):
+        """One page, newest first. `after` is the cursor of the previous page;
+        keyset pagination on (created_at, id), so pages stay consistent while
+        new items arrive at the top. Returns (items, generation, next_cursor),
+        next_cursor being None on the last page."""
         with self.lock:
             query = "SELECT * FROM items WHERE 1=1"
             params = []
@@ -103,65 +300,106 @@ class ClipmanDB:
             if favorites_only or filter_type == "favorites":
                 query += " AND is_favorite = 1"
 
-            if search:
+            if search and not self.search_index:
                 query += " AND preview LIKE ?"
                 params.append(f"%{search}%")
+            elif search and len(search) >= 3:
+                # Candidates from the trigram index
+                query += " AND id IN (SELECT rowid FROM items_fts WHERE body LIKE ?)"
+                params.append(f"%{search}%")
+            elif search:
+                # Too short for trigrams: check newest first, stop at the limit
+                query += " AND (SELECT body FROM items_fts WHERE rowid = items.id) LIKE ?"
+                params.append(f"%{search}%")
 
-            query += " ORDER BY created_at DESC LIMIT ?"
-            params.append(limit)
+            if after:
+                created_at, _, after_id = after.rpartition("|")
+                query += " AND (created_at < ? OR (created_at = ? AND id < ?))"
+                params += [created_at, created_at, int(after_id)]
 
-            return [dict(row) for row in self.conn.execute(query, params).fetchall()]
+            # One extra row tells whether another page follows
+            query += " ORDER BY created_at DESC, id DESC LIMIT ?"
+            params.append(limit + 1)
+
+            rows = [dict(row) for row in self.conn.execute(query, params).fetchall()]
+            next_cursor = None
+            if len(rows) > limit:
+                rows = rows[:limit]
+                next_cursor = f"{rows[-1]['created_at']}|{rows[-1]['id']}"
+            return rows, self.generation, next_cursor
 
     def toggle_favorite(self, item_uuid):
+        self.set_favorites([item_uuid])
+
+    def set_favorites(self, uuids, favorite=None):
+        """Set the favorite flag of several items (toggle each when favorite
+        is None) in one transaction. Returns (generation, changes)."""
         with self.lock:
-            self.conn.execute(
-                "UPDATE items SET is_favorite = NOT is_favorite WHERE uuid = ?",
-                (item_uuid,)
-            )
+            changes = []
+            for item_uuid in uuids:
+                if favorite is None:
+                    cur = self.conn.execute(
+                        "UPDATE items SET is_favorite = NOT is_favorite WHERE uuid = ?",
+                        (item_uuid,)
+                    )
+                else:
+                    cur = self.conn.execute(
+                        "UPDATE items SET is_favorite = ? WHERE uuid = ? AND is_favorite != ?",
+                        (int(favorite), item_uuid, int(favorite))
+                    )
+                if cur.rowcount:
+                    row = self._item_row(item_uuid)
+                    changes.append({"op": "favorite", "uuid": item_uuid,
+                                    "favorite": bool(row['is_favorite'])})
             self.conn.commit()
+            if changes:
+                self._publish(changes)
+            return self.generation, changes
 
     def delete_item(self, item_uuid):
-        with self.lock:
-            row = self.conn.execute(
-                "SELECT file_path, thumb_path FROM items WHERE uuid = ?",
-                (item_uuid,)
-            ).fetchone()
-
-            if row:
-                # Delete associated files
-                for path in [row['file_path'], row['thumb_path']]:
-                    if path:
-                        full_path = CONFIG["data_dir"] / path
-                        if full_path.exists():
-                            try:
-                                full_path.unlink()
-                            except OSError:
-                                pass
+        self.delete_items([item_uuid])
 
+    def delete_items(self, uuids):
+        """Delete several items in one transaction; their files go once it
+        has committed. Returns (generation, changes)."""
+        with self.lock:
+            changes = []
+            paths = []
+            for item_uuid in uuids:
+                row = self.conn.execute(
+                    "SELECT file_path, thumb_path FROM items WHERE uuid = ?",
+                    (item_uuid,)
+                ).fetchone()
+                if not row:
+                    continue
+                paths += [row['file_path'], row['thumb_path']]
                 self.conn.execute("DELETE FROM items WHERE uuid = ?", (item_uuid,))
-                self.conn.commit()
+                changes.append({"op": "delete", "uuid": item_uuid})
+            self.conn.commit()
+            self._drop_files(paths)
+
+            if changes:
+                self._publish(changes)
+            return self.generation, changes
 
     def clear_non_favorites(self):
         with self.lock:
             rows = self.conn.execute(
-                "SELECT file_path, thumb_path FROM items WHERE is_favorite = 0"
+                "SELECT uuid, file_path, thumb_path FROM items WHERE is_favorite = 0"
             ).fetchall()
 
-            for row in rows:
-                for path in [row['file_path'], row['thumb_path']]:
-                    if path:
-                        full_path = CONFIG["data_dir"] / path
-                        if full_path.exists():
-                            try:
-                                full_path.unlink()
-                            except OSError:
-                                pass
-
             self.conn.execute("DELETE FROM items WHERE is_favorite = 0")
             self.conn.commit()
+            self._drop_files([path for row in rows
+                              for path in (row['file_path'], row['thumb_path'])])
+            if rows:
+                self._publish([{"op": "delete", "uuid": row['uuid']} for row in rows])
 
     def _cleanup(self):
-        """Remove oldest non-favorite items when exceeding max_items"""
+        """Remove oldest non-favorite items when exceeding max_items.
+        Returns the uuids removed."""
+        removed = []
+        paths = []
         count = self.conn.execute("SELECT COUNT(*) FROM items").fetchone()[0]
 
         if count > CONFIG["max_items"]:
@@ -180,49 +418,179 @@ class ClipmanDB:
                 ).fetchone()
 
                 if file_row:
-                    for path in [file_row['file_path'], file_row['thumb_path']]:
-                        if path:
-                            full_path = CONFIG["data_dir"] / path
-                            if full_path.exists():
-                                try:
-                                    full_path.unlink()
-                                except OSError:
-                                    pass
-
                     self.conn.execute("DELETE FROM items WHERE uuid = ?", (item_uuid,))
+                    paths += [file_row['file_path'], file_row['thumb_path']]
+                    removed.append(item_uuid)
 
             self.conn.commit()
+            self._drop_files(paths)
+        return removed
 
 
 class ContentStore:
-    """File-based content storage for clipboard data"""
+    """Content-addressed, reference-counted payload storage.
+
+    Payloads are keyed by content_key(); an item's file_path is
+    "blob/<key>". Up to LARGE_BLOB they are appended to segment files
+    (blobs/<n>.seg), larger ones get a file of their own (blobs/<key>).
+    Text is zlib-compressed when that pays off. The index (blobs.db) maps a
+    key to its location and reference count: duplicates share storage and a
+    lookup is one primary-key read. Appends are not fsync'ed one by one; a
+    segment is synced when sealed. Once half of a sealed segment is dead,
+    its live blobs move to the active segment and the file goes."""
 
     def __init__(self, base_path):
         self.base_path = Path(base_path)
-        (self.base_path / "text").mkdir(parents=True, exist_ok=True)
-        (self.base_path / "images").mkdir(parents=True, exist_ok=True)
+        self.blob_dir = self.base_path / "blobs"
+        self.blob_dir.mkdir(parents=True, exist_ok=True)
         (self.base_path / "thumbs").mkdir(parents=True, exist_ok=True)
 
+        self.lock = threading.Lock()
+        self.conn = sqlite3.connect(str(self.blob_dir / "blobs.db"), check_same_thread=False)
+        self.conn.row_factory = sqlite3.Row
+        self.conn.execute("PRAGMA journal_mode=WAL")
+        self.conn.execute("PRAGMA synchronous=NORMAL")
+        self.conn.executescript('''
+            CREATE TABLE IF NOT EXISTS blobs (
+                key TEXT PRIMARY KEY,
+                segment INTEGER NOT NULL,   -- 0: file of its own
+                offset INTEGER NOT NULL,
+                length INTEGER NOT NULL,    -- stored (possibly compressed) bytes
+                codec TEXT NOT NULL,        -- "raw" or "zlib"
+                refs INTEGER NOT NULL
+            ) WITHOUT ROWID;
+            CREATE TABLE IF NOT EXISTS segments (
+                id INTEGER PRIMARY KEY,
+                size INTEGER NOT NULL DEFAULT 0,
+                dead INTEGER NOT NULL DEFAULT 0
+            );
+        ''')
+        self.conn.commit()
+
+    def _segment_path(self, segment):
+        return self.blob_dir / f"{segment}.seg"
+
+    def _append(self, payload):
+        """Append to the active segment (caller holds self.lock).
+        Returns (segment, offset)."""
+        row = self.conn.execute(
+            "SELECT id, size FROM segments ORDER BY id DESC LIMIT 1").fetchone()
+        if not row or row['size'] >= SEGMENT_SIZE:
+            segment = self.conn.execute("INSERT INTO segments DEFAULT VALUES").lastrowid
+            offset = 0
+        else:
+            segment, offset = row['id'], row['size']
+
+        with open(self._segment_path(segment), "ab") as f:
+            f.seek(offset)
+            f.truncate()  # drop a tail left by an append the index never saw
+            f.write(payload)
+            if offset + len(payload) >= SEGMENT_SIZE:
+                f.flush()
+                os.fsync(f.fileno())  # sealed from now on
+        self.conn.execute("UPDATE segments SET size = ? WHERE id = ?",
+                          (offset + len(payload), segment))
+        return segment, offset
+
+    def put(self, data, compress=False):
+        """Store a payload and take a reference on it; the caller releases it
+        with release(file_path). Returns (file_path, key)."""
+        key = content_key(data)
+        with self.lock:
+            if self.conn.execute("UPDATE blobs SET refs = refs + 1 WHERE key = ?",
+                                 (key,)).rowcount == 0:
+                payload, codec = data, "raw"
+                if compress:
+                    packed = zlib.compress(data, 6)
+                    if len(packed) < len(data):
+                        payload, codec = packed, "zlib"
+
+                if len(payload) > LARGE_BLOB:
+                    (self.blob_dir / key).write_bytes(payload)
+                    segment, offset = 0, 0
+                else:
+                    segment, offset = self._append(payload)
+                self.conn.execute(
+                    "INSERT INTO blobs (key, segment, offset, length, codec, refs) "
+                    "VALUES (?, ?, ?, ?, ?, 1)",
+                    (key, segment, offset, len(payload), codec))
+            self.conn.commit()
+        return f"blob/{key}", key
+
+    def _read(self, row):
+        if row['segment'] == 0:
+            payload = (self.blob_dir / row['key']).read_bytes()
+        else:
+            with open(self._segment_path(row['segment']), "rb") as f:
+                f.seek(row['offset'])
+                payload = f.read(row['length'])
+        return zlib.decompress(payload) if row['codec'] == "zlib" else payload
+
+    def release(self, file_path):
+        """Drop a reference taken by put(); also deletes plain files
+        (thumbnails, payloads from before the blob store)"""
+        if not file_path.startswith("blob/"):
+            try:
+                (self.base_path / file_path).unlink()
+            except OSError:
+                pass
+            return
+
+        key = file_path[len("blob/"):]
+        with self.lock:
+            row = self.conn.execute("SELECT * FROM blobs WHERE key = ?", (key,)).fetchone()
+            if not row:
+                return
+            if row['refs'] > 1:
+                self.conn.execute("UPDATE blobs SET refs = refs - 1 WHERE key = ?", (key,))
+            else:
+                self.conn.execute("DELETE FROM blobs WHERE key = ?", (key,))
+                if row['segment'] == 0:
+                    (self.blob_dir / key).unlink(missing_ok=True)
+                else:
+                    self.conn.execute("UPDATE segments SET dead = dead + ? WHERE id = ?",
+                                      (row['length'], row['segment']))
+                    self._maybe_compact(row['segment'])
+            self.conn.commit()
+
+    def _maybe_compact(self, segment):
+        """Move a sealed segment's live blobs out once it is half dead
+        (caller holds self.lock)"""
+        seg = self.conn.execute("SELECT * FROM segments WHERE id = ?", (segment,)).fetchone()
+        if not seg or seg['size'] < SEGMENT_SIZE or seg['dead'] * 2 < seg['size']:
+            return
+        live = self.conn.execute("SELECT * FROM blobs WHERE segment = ?", (segment,)).fetchall()
+        with open(self._segment_path(segment), "rb") as f:
+            for row in live:
+                f.seek(row['offset'])
+                new_segment, new_offset = self._append(f.read(row['length']))
+                self.conn.execute("UPDATE blobs SET segment = ?, offset = ? WHERE key = ?",
+                                  (new_segment, new_offset, row['key']))
+        self.conn.execute("DELETE FROM segments WHERE id = ?", (segment,))
+        self.conn.commit()
+        self._segment_path(segment).unlink(missing_ok=True)
+
+    def close(self):
+        """Sync the active segment (called on shutdown)"""
+        with self.lock:
+            row = self.conn.execute(
+                "SELECT id FROM segments ORDER BY id DESC LIMIT 1").fetchone()
+            if row and self._segment_path(row['id']).exists():
+                with open(self._segment_path(row['id']), "rb+") as f:
+                    os.fsync(f.fileno())
+
     def store_text(self, content):
         """Store text content and return (uuid, file_path, hash)"""
         item_uuid = str(uuid.uuid4())
-        content_bytes = content.encode('utf-8')
-        content_hash = hashlib.sha256(content_bytes).hexdigest()
-        file_path = f"text/{item_uuid}.txt"
-        full_path = self.base_path / file_path
-        full_path.write_text(content, encoding='utf-8')
+        file_path, content_hash = self.put(content.encode('utf-8'), compress=True)
         return item_uuid, file_path, content_hash
 
     def store_image(self, image_bytes):
         """Store image content and return (uuid, file_path, thumb_path, hash)"""
         item_uuid = str(uuid.uuid4())
-        content_hash = hashlib.sha256(image_bytes).hexdigest()
-        file_path = f"images/{item_uuid}.png"
+        file_path, content_hash = self.put(image_bytes)
         thumb_path = f"thumbs/{item_uuid}.png"
 
-        full_path = self.base_path / file_path
-        full_path.write_bytes(image_bytes)
-
         # Generate thumbnail
         try:
             from PIL import Image
@@ -240,7 +608,19 @@ class ContentStore:
         return item_uuid, file_path, thumb_path, content_hash
 
     def get_content(self, file_path):
-        """Retrieve content from file"""
+        """Retrieve content: bytes from the blob store, str / bytes from a
+        file kept from before it"""
+        if file_path.startswith("blob/"):
+            with self.lock:
+                row = self.conn.execute("SELECT * FROM blobs WHERE key = ?",
+                                        (file_path[len("blob/"):],)).fetchone()
+                if not row:
+                    return None
+                try:
+                    return self._read(row)
+                except (OSError, zlib.error):
+                    return None
+
         full_path = self.base_path / file_path
         if not full_path.exists():
             return None
@@ -251,7 +631,13 @@ class ContentStore:
 
 
 class ClipboardWatcher:
-    """Watch clipboard changes via wl-paste"""
+    """Watch clipboard changes. Event-driven while the hyprclipx plugin
+    publishes selection changes on CONFIG["selection_socket"]: one capture
+    per copy, no idle wakeups. Without the plugin, polls wl-paste every
+    POLL_INTERVAL seconds and looks for the socket again each round."""
+
+    POLL_INTERVAL = 0.5
+    TEXT_TYPES = {"UTF8_STRING", "STRING", "TEXT"}  # besides text/plain*
 
     def __init__(self, on_text, on_image):
         self.on_text = on_text
@@ -259,19 +645,23 @@ class ClipboardWatcher:
         self.running = False
         self.last_text_hash = None
         self.last_image_hash = None
-        self.text_proc = None
+        self.events = None
+        # Selection events seen, for paste confirmation
+        self.selections = 0
+        self.selection_changed = threading.Condition()
 
     def start(self):
         self.running = True
-        # Watch text clipboard
-        threading.Thread(target=self._watch_text, daemon=True).start()
-        # Watch image clipboard
-        threading.Thread(target=self._watch_image, daemon=True).start()
+        threading.Thread(target=self._watch, daemon=True).start()
 
     def stop(self):
         self.running = False
-        if self.text_proc:
-            self.text_proc.terminate()
+        events = self.events
+        if events:
+            try:
+                events.shutdown(socket.SHUT_RDWR)
+            except OSError:
+                pass
 
     @staticmethod
     def _run_with_timeout(cmd, timeout=2):
@@ -290,57 +680,139 @@ class ClipboardWatcher:
             proc.communicate()
             return None, None
 
-    def _watch_text(self):
-        """Poll for text clipboard changes"""
+    def selection_mark(self):
+        with self.selection_changed:
+            return self.selections
+
+    def wait_selection(self, mark, timeout):
+        """Wait for a selection event after `mark` (see selection_mark).
+        False on timeout, or at once while polling: no events to wait for."""
+        with self.selection_changed:
+            return self.selection_changed.wait_for(
+                lambda: self.selections != mark or self.events is None,
+                timeout) and self.selections != mark
+
+    def _watch(self):
         while self.running:
-            try:
-                rc, stdout = self._run_with_timeout(["wl-paste", "--no-newline"])
+            events = self._connect_events()
+            if events:
+                print("Clipboard: following selection events from the hyprclipx plugin")
+                self._follow_events(events)
+                if self.running:
+                    print("Clipboard: plugin gone, polling wl-paste")
+                continue
+
+            self._capture_text()
+            self._capture_image()
+            time.sleep(self.POLL_INTERVAL)
 
-                if rc == 0 and stdout:
-                    content_hash = hashlib.sha256(stdout).hexdigest()
+    def _connect_events(self):
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        try:
+            sock.connect(CONFIG["selection_socket"])
+        except OSError:
+            sock.close()
+            return None
+        self.events = sock
+        return sock
 
-                    if content_hash != self.last_text_hash:
-                        try:
-                            text = stdout.decode('utf-8')
-                            if text.strip():
-                                self.last_text_hash = content_hash
-                                self.on_text(text)
-                        except UnicodeDecodeError:
-                            pass
+    def _follow_events(self, sock):
+        """Capture on every selection change until the plugin goes away.
+        The plugin sends the current selection first, so nothing copied
+        while we were polling (or not running) is lost."""
+        try:
+            with sock, sock.makefile("rb") as lines:
+                for line in lines:
+                    try:
+                        event = json.loads(line)
+                    except ValueError:
+                        continue
+                    if event.get("event") != "selection":
+                        continue
+                    # Before capturing: a paste waiting for this is done
+                    with self.selection_changed:
+                        self.selections += 1
+                        self.selection_changed.notify_all()
+                    mime_types = event.get("mime_types") or []
+                    if any(m.startswith("text/plain") or m in self.TEXT_TYPES
+                           for m in mime_types):
+                        self._capture_text()
+                    if "image/png" in mime_types:
+                        self._capture_image()
+        except OSError:
+            pass
+        finally:
+            with self.selection_changed:
+                self.events = None
+                self.selection_changed.notify_all()
 
-            except Exception as e:
-                print(f"Text watcher error: {e}", file=sys.stderr)
+    def _capture_text(self):
+        try:
+            rc, stdout = self._run_with_timeout(["wl-paste", "--no-newline"])
 
-            time.sleep(0.5)
+            if rc == 0 and stdout:
+                content_hash = content_key(stdout)
 
-    def _watch_image(self):
-        """Poll for image clipboard changes"""
-        while self.running:
-            try:
-                rc, stdout = self._run_with_timeout(["wl-paste", "--type", "image/png"])
+                if content_hash != self.last_text_hash:
+                    try:
+                        text = stdout.decode('utf-8')
+                        if text.strip():
+                            self.last_text_hash = content_hash
+                            self.on_text(text)
+                    except UnicodeDecodeError:
+                        pass
+
+        except Exception as e:
+            print(f"Text watcher error: {e}", file=sys.stderr)
 
-                if rc == 0 and stdout:
-                    content_hash = hashlib.sha256(stdout).hexdigest()
+    def _capture_image(self):
+        try:
+            rc, stdout = self._run_with_timeout(["wl-paste", "--type", "image/png"])
 
-                    if content_hash != self.last_image_hash:
-                        self.last_image_hash = content_hash
-                        self.on_image(stdout)
+            if rc == 0 and stdout:
+                content_hash = content_key(stdout)
+
+                if content_hash != self.last_image_hash:
+                    self.last_image_hash = content_hash
+                    self.on_image(stdout)
+
+        except Exception as e:
+            print(f"Image watcher error: {e}", file=sys.stderr)
 
-            except Exception as e:
-                print(f"Image watcher error: {e}", file=sys.stderr)
 
-            time.sleep(0.5)
+class MuxClient:
+    """One persistent connection; replies and pushes share the send lock"""
+
+    def __init__(self, conn):
+        self.conn = conn
+        self.send_lock = threading.Lock()
+        self.subscribed = False  # receives change events, not just generations
+
+    def send(self, request_id, payload):
+        frame = encode_frame({"id": request_id, **payload})
+        with self.send_lock:
+            self.conn.sendall(frame)
+
+    def push(self, event):
+        self.send(0, event)
 
 
 class IPCServer:
     """UNIX socket server for IPC commands"""
 
-    def __init__(self, socket_path, db, store):
+    def __init__(self, socket_path, db, store, watcher):
         self.socket_path = socket_path
         self.db = db
         self.store = store
+        self.watcher = watcher
         self.running = False
         self.server = None
+        # Connected persistent clients
+        self.clients = set()
+        self.clients_lock = threading.Lock()
+        # Changes waiting for the broadcaster, in commit order
+        self.outbox = queue.Queue()
+        db.listeners.append(self._on_change)
 
     def start(self):
         self.running = True
@@ -356,6 +828,8 @@ class IPCServer:
 
         print(f"Clipman IPC server listening on {self.socket_path}")
 
+        threading.Thread(target=self._broadcast, daemon=True).start()
+
         while self.running:
             try:
                 conn, _ = self.server.accept()
@@ -370,6 +844,28 @@ class IPCServer:
                 if self.running:
                     print(f"Server error: {e}", file=sys.stderr)
 
+    def _on_change(self, generation, changes):
+        # Runs under the DB lock: only queue, the broadcaster does the sending
+        self.outbox.put((generation, changes))
+
+    def _broadcast(self):
+        """Push every mutation as an unsolicited frame (id 0), in commit order.
+        Subscribed clients get the changes themselves, the others just the
+        new generation so their caches notice without asking."""
+        while True:
+            generation, changes = self.outbox.get()
+            with self.clients_lock:
+                clients = list(self.clients)
+            for client in clients:
+                try:
+                    if client.subscribed:
+                        client.push({"event": "change", "generation": generation,
+                                     "changes": changes})
+                    else:
+                        client.push({"event": "generation", "generation": generation})
+                except OSError:
+                    pass  # connection handler cleans up
+
     def stop(self):
         self.running = False
         if self.server:
@@ -378,75 +874,162 @@ class IPCServer:
             os.unlink(self.socket_path)
 
     def _handle_client(self, conn):
+        # Persistent clients (hyprclipx-ui) announce themselves with a preamble;
+        # everything else is a legacy one-shot request (clipman-client.py)
+        try:
+            if conn.recv(len(MUX_PREAMBLE), socket.MSG_PEEK) == MUX_PREAMBLE:
+                conn.recv(len(MUX_PREAMBLE))
+                self._handle_mux_client(conn)
+                return
+        except Exception:
+            conn.close()
+            return
+
         try:
-            data = conn.recv(65536).decode('utf-8')
-            request = json.loads(data)
+            request = self._read_legacy_request(conn)
             response = self._process_command(request)
-            conn.send(json.dumps(response).encode('utf-8'))
+            conn.sendall(json.dumps(response).encode('utf-8'))
         except Exception as e:
             error_response = {"status": "error", "error": str(e)}
             try:
-                conn.send(json.dumps(error_response).encode('utf-8'))
+                conn.sendall(json.dumps(error_response).encode('utf-8'))
             except Exception:
                 pass
         finally:
             conn.close()
 
+    @staticmethod
+    def _read_legacy_request(conn):
+        """Unframed request: read until the buffer holds one complete JSON value"""
+        data = b""
+        while len(data) < MAX_FRAME_SIZE:
+            chunk = conn.recv(65536)
+            if not chunk:
+                break
+            data += chunk
+            try:
+                return json.loads(data.decode('utf-8'))
+            except ValueError:
+                continue  # partial read, keep going
+        return json.loads(data.decode('utf-8'))
+
+    def _handle_mux_client(self, conn):
+        """Long-lived connection: length-prefixed JSON frames, each request
+        tagged with an "id". Requests run concurrently, replies carry the same
+        id and may arrive out of order. List replies are streamed as several
+        frames so the client can render the first items early."""
+        client = MuxClient(conn)
+        reply = client.send
+
+        def run(request):
+            request_id = request.get("id")
+            try:
+                if request.get("cmd") == "subscribe":
+                    self._subscribe(client, request_id, request.get("args", {}))
+                    return
+                response = self._process_command(request)
+                if request.get("cmd") == "list" and response.get("status") == "ok":
+                    self._send_chunked(client, request_id, response, response.pop("data"))
+                    return
+            except OSError:
+                return  # client went away
+            except Exception as e:
+                response = {"status": "error", "error": str(e)}
+            try:
+                reply(request_id, response)
+            except OSError:
+                pass  # client went away
+
+        with self.clients_lock:
+            self.clients.add(client)
+
+        buf = b""
+        try:
+            client.push({"event": "generation", "generation": self.db.generation})
+            while self.running:
+                chunk = conn.recv(65536)
+                if not chunk:
+                    break
+                buf += chunk
+                while len(buf) >= 4:
+                    (length,) = struct.unpack(">I", buf[:4])
+                    if length > MAX_FRAME_SIZE:
+                        return  # corrupt stream
+                    if len(buf) < 4 + length:
+                        break
+                    payload, buf = buf[4:4 + length], buf[4 + length:]
+                    try:
+                        request = json.loads(payload.decode('utf-8'))
+                    except ValueError as e:
+                        reply(None, {"status": "error", "error": f"Invalid request: {e}"})
+                        continue
+                    threading.Thread(target=run, args=(request,), daemon=True).start()
+        except OSError:
+            pass
+        finally:
+            with self.clients_lock:
+                self.clients.discard(client)
+            conn.close()
+
+    @staticmethod
+    def _send_chunked(client, request_id, envelope, items):
+        """Stream `items` as LIST_CHUNK_SIZE frames; all but the last carry
+        "more": true"""
+        for start in range(0, len(items), LIST_CHUNK_SIZE):
+            chunk = items[start:start + LIST_CHUNK_SIZE]
+            more = start + LIST_CHUNK_SIZE < len(items)
+            client.send(request_id, {**envelope, "more": more, "data": chunk})
+        if not items:
+            client.send(request_id, {**envelope, "more": False, "data": []})
+
+    def _subscribe(self, client, request_id, args):
+        """Start pushing changes to `client` and answer with what it missed
+        since generation args["since"]: the changes themselves, or a full
+        snapshot (streamed like a list reply, "resync": true) when the
+        changelog no longer reaches back that far, e.g. after a restart."""
+        try:
+            since = int(args.get("since", 0))
+        except (TypeError, ValueError):
+            since = 0
+
+        def enable():
+            client.subscribed = True
+
+        generation, changes, items = self.db.sync(since, enable)
+        if changes is not None:
+            client.send(request_id, {"status": "ok", "generation": generation,
+                                     "resync": False, "changes": changes})
+        else:
+            self._send_chunked(client, request_id,
+                               {"status": "ok", "generation": generation, "resync": True},
+                               items)
+
     def _process_command(self, request):
         cmd = request.get("cmd")
         args = request.get("args", {})
 
         if cmd == "list":
-            items = self.db.get_items(
+            items, generation, next_cursor = self.db.get_items(
                 filter_type=args.get("filter", "all"),
                 favorites_only=args.get("favorites", False),
                 search=args.get("search", ""),
-                limit=args.get("limit", 50)
+                limit=args.get("limit", 50),
+                after=args.get("after")
             )
 
             # Enrich items with full paths and normalized fields
-            for item in items:
-                if item.get("thumb_path"):
-                    item["thumb"] = str(CONFIG["data_dir"] / item["thumb_path"])
-                item["favorite"] = bool(item.get("is_favorite"))
-                item["type"] = item.get("content_type")
+            items = [public_item(item) for item in items]
 
-            return {"status": "ok", "data": items}
+            response = {"status": "ok", "generation": generation}
+            if next_cursor:
+                response["next_cursor"] = next_cursor
+            response["data"] = items
+            return response
 
         elif cmd == "paste":
-            item_uuid = args.get("uuid")
-            row = self.db.conn.execute(
-                "SELECT file_path, content_type FROM items WHERE uuid = ?",
-                (item_uuid,)
-            ).fetchone()
-
-            if row:
-                content = self.store.get_content(row["file_path"])
-                if content is None:
-                    return {"status": "error", "error": "Content file not found"}
-
-                if row["content_type"] == "text":
-                    # Strip trailing whitespace from each line + trailing empty lines
-                    if isinstance(content, str):
-                        content = '\n'.join(line.rstrip() for line in content.split('\n'))
-                        content = content.rstrip('\n')
-                    elif isinstance(content, bytes):
-                        content = b'\n'.join(line.rstrip() for line in content.split(b'\n'))
-                        content = content.rstrip(b'\n')
-                    subprocess.run(
-                        ["wl-copy", "--"],
-                        input=content.encode('utf-8') if isinstance(content, str) else content,
-                        check=True
-                    )
-                else:
-                    subprocess.run(
-                        ["wl-copy", "--type", "image/png"],
-                        input=content,
-                        check=True
-                    )
-                return {"status": "ok"}
-
-            return {"status": "error", "error": "Item not found"}
+            # "uuids" pastes several text items at once, joined by newlines
+            uuids = args.get("uuids") or [args.get("uuid")]
+            return self._paste(uuids)
 
         elif cmd == "favorite":
             self.db.toggle_favorite(args.get("uuid"))
@@ -456,6 +1039,18 @@ class IPCServer:
             self.db.delete_item(args.get("uuid"))
             return {"status": "ok"}
 
+        # Batch mutations: one request, one transaction, one generation. The
+        # reply carries the resulting changes so clients can apply them locally.
+        elif cmd == "favorite_many":
+            favorite = args.get("favorite")
+            generation, changes = self.db.set_favorites(
+                args.get("uuids", []), None if favorite is None else bool(favorite))
+            return {"status": "ok", "generation": generation, "changes": changes}
+
+        elif cmd == "delete_many":
+            generation, changes = self.db.delete_items(args.get("uuids", []))
+            return {"status": "ok", "generation": generation, "changes": changes}
+
         elif cmd == "clear":
             self.db.clear_non_favorites()
             return {"status": "ok"}
@@ -463,8 +1058,63 @@ class IPCServer:
         elif cmd == "ping":
             return {"status": "ok", "message": "pong"}
 
+        elif cmd == "generation":
+            return {"status": "ok", "generation": self.db.generation}
+
+        elif cmd == "subscribe":
+            return {"status": "error", "error": "subscribe needs a framed connection"}
+
         return {"status": "error", "error": f"Unknown command: {cmd}"}
 
+    def _copy(self, args, data):
+        """wl-copy `data`; returns once the compositor has the new selection
+        (reported by the plugin), so the client can send the paste keys"""
+        mark = self.watcher.selection_mark()
+        subprocess.run(["wl-copy", *args], input=data, check=True)
+        if self.watcher.events is None:
+            time.sleep(PASTE_SETTLE)
+        else:
+            self.watcher.wait_selection(mark, PASTE_CONFIRM_TIMEOUT)
+
+    def _paste(self, uuids):
+        """Put the items' content on the clipboard (wl-copy)"""
+        with self.db.lock:
+            rows = []
+            for item_uuid in uuids:
+                row = self.db.conn.execute(
+                    "SELECT file_path, content_type FROM items WHERE uuid = ?",
+                    (item_uuid,)
+                ).fetchone()
+                if row:
+                    rows.append(row)
+
+        if not rows:
+            return {"status": "error", "error": "Item not found"}
+
+        if len(rows) == 1 and rows[0]["content_type"] != "text":
+            content = self.store.get_content(rows[0]["file_path"])
+            if content is None:
+                return {"status": "error", "error": "Content file not found"}
+            self._copy(["--type", "image/png"], content)
+            return {"status": "ok"}
+
+        if any(row["content_type"] != "text" for row in rows):
+            return {"status": "error", "error": "Only text items can be pasted together"}
+
+        texts = []
+        for row in rows:
+            content = self.store.get_content(row["file_path"])
+            if content is None:
+                return {"status": "error", "error": "Content file not found"}
+            if isinstance(content, bytes):
+                content = content.decode('utf-8', errors='replace')
+            # Strip trailing whitespace from each line + trailing empty lines
+            content = '\n'.join(line.rstrip() for line in content.split('\n'))
+            texts.append(content.rstrip('\n'))
+
+        self._copy(["--"], '\n'.join(texts).encode('utf-8'))
+        return {"status": "ok"}
+
 
 def is_sensitive(text: str) -> bool:
     """Detect password-like strings via heuristics.
@@ -511,9 +1161,10 @@ def main():
     CONFIG["data_dir"].mkdir(parents=True, exist_ok=True)
 
     # Initialize components
-    db = ClipmanDB(CONFIG["data_dir"] / "clipman.db")
     store = ContentStore(CONFIG["data_dir"])
-    server = IPCServer(CONFIG["socket_path"], db, store)
+    db = ClipmanDB(CONFIG["data_dir"] / "clipman.db", store)
+    db.migrate_payloads()
+    db.build_search_index()
 
     def on_text(text):
         """Handle new text clipboard content"""
@@ -526,7 +1177,8 @@ def main():
         line_count = text.count('\n') + 1
         stored_uuid = db.add_item(
             item_uuid, "text", preview, content_hash,
-            file_path, None, len(text.encode('utf-8')), line_count
+            file_path, None, len(text.encode('utf-8')), line_count,
+            search_text=preview if sensitive else text
         )
         print(f"Stored text: {preview[:50]}...")
 
@@ -572,12 +1224,14 @@ def main():
     # Start clipboard watcher
     watcher = ClipboardWatcher(on_text, on_image)
     watcher.start()
+    server = IPCServer(CONFIG["socket_path"], db, store, watcher)
 
     # Handle shutdown signals
     def shutdown(signum, frame):
         print("\nShutting down...")
         watcher.stop()
         server.stop()
+        store.close()
         sys.exit(0)
 
     signal.signal(signal.SIGINT, shutdown)
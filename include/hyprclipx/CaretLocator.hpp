@@ -0,0 +1,39 @@
+#pragma once
+// Text caret lookup for placing the popup (plugin side). Clients using
+// text-input report their caret to the compositor, and the caller passes it
+// in. For the others, asks the resident caret-daemon, which follows the
+// caret from AT-SPI events, over a kept-open socket; without it, falls back
+// to the one-shot helper (a Python start plus a D-Bus walk, tens to hundreds
+// of ms). Lookups run on one worker thread, never in the compositor's.
+// Results are handed back on the compositor's event loop, in request order.
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace hyprclipx {
+
+struct CaretLookup {
+    std::string socket;             // caret-daemon
+    std::string helper;             // get-caret-position.py, if it isn't running
+    int pid;                        // focused window's client, 0 = any
+    int monX, monY, monW, monH;     // monitor of the focused window
+    // Caret already known on the compositor side (text-input cursor
+    // rectangle): no lookup, it only keeps its place in the queue
+    std::optional<std::pair<int, int>> known = std::nullopt;
+    // Mouse cursor at the hotkey, the fallback when no caret is found
+    std::optional<std::pair<int, int>> cursor = std::nullopt;
+};
+
+// Caret in logical coordinates, clamped to the monitor; the mouse cursor
+// when no caret can be found, nullopt when neither can
+using CaretCallback = std::function<void(std::optional<std::pair<int, int>>)>;
+
+bool startCaretLocator();
+// Waits for a lookup in progress; pending callbacks are dropped
+void stopCaretLocator();
+
+void locateCaret(CaretLookup lookup, CaretCallback done);
+
+} // namespace hyprclipx
@@ -1,7 +1,9 @@
 #pragma once
 // Data structure matching clipman-daemon's JSON response
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace hyprclipx {
 
@@ -12,6 +14,29 @@ struct ClipboardEntry {
     std::string thumb;        // Full path to thumbnail (images only)
     bool favorite = false;
     std::string createdAt;
+    bool fullPreview = false;         // preview is all the text search matches (not cut short)
+    std::vector<uint32_t> highlight;  // byte offsets in preview matched by a local search
+
+    bool operator==(const ClipboardEntry&) const = default;
+};
+
+// One page of a "list" reply
+struct ListPage {
+    std::vector<ClipboardEntry> items;  // newest first
+    uint64_t generation = 0;            // history generation it was read at (0 = unknown)
+    std::string nextCursor;             // "after" for the next page ("" = last page)
+};
+
+// One entry of the daemon's change feed ("subscribe")
+struct HistoryChange {
+    enum class Op {
+        Insert,     // new item, newest first
+        Update,     // item copied again: new fields, moves to the top
+        Delete,     // only item.uuid is set
+        Favorite,   // only item.uuid and item.favorite are set
+    };
+    Op op = Op::Insert;
+    ClipboardEntry item;
 };
 
 } // namespace hyprclipx
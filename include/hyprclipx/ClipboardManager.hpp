@@ -1,10 +1,24 @@
 #pragma once
 // IPC client for clipman-daemon (Unix socket on /tmp/clipman.sock)
 // Mirrors AGS's execAsync("python3 clipman-client.py ...") calls
+//
+// Fully asynchronous: the socket is non-blocking and driven by fd watches on
+// the default GMainContext. Every call returns immediately; callbacks always
+// run later on the main thread (never re-entrantly from the call itself).
 
 #include "ClipboardEntry.hpp"
 #include "Config.hpp"
+#include "EntryStore.hpp"
+#include "Framing.hpp"
+#include "JsonParser.hpp"
+#include <glib.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace hyprclipx {
@@ -12,25 +26,130 @@ namespace hyprclipx {
 class ClipboardManager {
 public:
     explicit ClipboardManager(const Config& config);
+    ~ClipboardManager();
 
-    // Daemon commands (matching clipman-client.py)
-    std::vector<ClipboardEntry> fetchItems(const std::string& filter = "all",
-                                           const std::string& search = "",
-                                           int limit = 50);
-    bool paste(const std::string& uuid);
-    bool toggleFavorite(const std::string& uuid);
-    bool deleteItem(const std::string& uuid);
-    bool clearAll();
-    bool ping();
+    ClipboardManager(const ClipboardManager&) = delete;
+    ClipboardManager& operator=(const ClipboardManager&) = delete;
+
+    // Called with every chunk of a streamed list reply as it arrives
+    using BatchCallback = std::function<void(const std::vector<ClipboardEntry>&)>;
+    // Called once with the complete page. A failed fetch (timeout, lost
+    // connection, error reply) gives the rows that did arrive, with
+    // generation 0 and no nextCursor.
+    using ListCallback = std::function<void(ListPage)>;
+    // Called once with the command's outcome
+    using ResultCallback = std::function<void(bool ok)>;
+    // Called with every raw reply frame (several for streamed replies)
+    using FrameCallback = std::function<void(const std::string&)>;
+    // Called once with a batch command's outcome and the changes it made
+    using ChangesCallback = std::function<void(bool ok, const std::vector<HistoryChange>& changes,
+                                               uint64_t generation)>;
+    // Called once with the final reply frame ("" on failure / timeout)
+    using ReplyCallback = std::function<void(const std::string&)>;
+
+    // Daemon commands (matching clipman-client.py). Each returns a request
+    // id usable with cancel(); if the daemon is unreachable the callback
+    // still fires (with a failure result) on the next main loop iteration.
+    // `after` is the previous page's nextCursor ("" = first page)
+    uint64_t fetchItems(const std::string& filter, const std::string& search, int limit,
+                        const std::string& after, BatchCallback onBatch, ListCallback onDone);
+    uint64_t paste(const std::string& uuid, ResultCallback done = {});
+    uint64_t toggleFavorite(const std::string& uuid, ResultCallback done = {});
+    uint64_t deleteItem(const std::string& uuid, ResultCallback done = {});
+    uint64_t clearAll(ResultCallback done = {});
+
+    // Batch commands: any number of items in one request and one daemon
+    // transaction. Several text items are pasted joined by newlines.
+    uint64_t paste(const std::vector<std::string>& uuids, ResultCallback done = {});
+    uint64_t setFavorite(const std::vector<std::string>& uuids, bool favorite,
+                         ChangesCallback done = {});
+    uint64_t deleteItems(const std::vector<std::string>& uuids, ChangesCallback done = {});
+    uint64_t ping(ResultCallback done = {});
+
+    // Generic request; any number may be in flight, replies arrive in any order
+    uint64_t request(const std::string& cmd, const std::string& argsJson,
+                     FrameCallback onFrame, ReplyCallback onReply);
+
+    // Drops a pending request's callbacks (the reply is discarded on arrival)
+    void cancel(uint64_t id);
+
+    // Receives the change feed set up by subscribe() (main thread)
+    struct FeedHandler {
+        // Full history at `generation`; replaces everything
+        std::function<void(std::shared_ptr<const EntryStore>, uint64_t generation)> onSnapshot;
+        // Changes committed up to `generation`, in commit order. Also called
+        // (possibly with no changes) once a resubscribe has caught up.
+        std::function<void(const std::vector<HistoryChange>&, uint64_t generation)> onChanges;
+        // Feed interrupted (daemon gone); it resumes by itself
+        std::function<void()> onLost;
+    };
+
+    // Keeps a change subscription alive from now on. After every (re)connect
+    // it asks for the changes since `since()`; the daemon answers with that
+    // delta, or with a full snapshot once its changelog no longer reaches back.
+    void subscribe(FeedHandler handler, std::function<uint64_t()> since);
+    bool feedLive() const { return m_feedLive; }
+
+    // Latest history generation the daemon announced on this connection.
+    // The daemon pushes every change, so a result read at this generation is
+    // still current. 0 while disconnected (changes may have been missed).
+    uint64_t generation() const { return m_generation; }
 
 private:
     const Config& m_config;
 
-    // Send command to daemon, return JSON response
-    std::string sendCommand(const std::string& cmd, const std::string& argsJson = "{}");
+    struct Pending {
+        std::string frame;          // encoded request, kept for one resend
+        bool idempotent = false;    // a read: may be resent after a reconnect
+        FrameCallback onFrame;
+        ReplyCallback onReply;
+        guint timeoutSource = 0;
+        bool receivedAny = false;   // part of the reply already handed out
+        bool resent = false;
+    };
+
+    // Long-lived, non-blocking connection (multiplexed by request id)
+    int m_sock = -1;
+    guint m_readWatch = 0;
+    guint m_writeWatch = 0;
+    uint64_t m_nextId = 1;
+    uint64_t m_connSerial = 0;      // bumped per connection, detects swaps mid-dispatch
+    uint64_t m_generation = 0;      // see generation()
+    FrameDecoder m_decoder;
+    std::string m_outBuf;           // bytes not yet accepted by the kernel
+    std::unordered_map<uint64_t, Pending> m_pending;
+
+    // Change feed
+    FeedHandler m_feed;
+    std::function<uint64_t()> m_feedSince;
+    uint64_t m_feedRequest = 0;     // subscribe request in flight
+    bool m_feedLive = false;        // subscribed on this connection and caught up
+    guint m_feedRetry = 0;
+    // Pushes that overtook the subscribe reply, replayed after it
+    std::vector<std::pair<uint64_t, std::vector<HistoryChange>>> m_feedBacklog;
+
+    bool ensureConnected();
+    void disconnect();
+    void onConnectionLost();
+    void queueWrite(std::string_view data);
+    bool flushWrites();
+    void handleFrame(const std::string& frame);
+    void handleEvent(const ReplyEnvelope& env, const std::string& frame);
+    void startFeed();
+    void scheduleFeedRetry(guint delayMs);
+    void finish(uint64_t id, const std::string& reply);
+    void failLater(uint64_t id);
+
+    static gboolean onReadable(gint fd, GIOCondition cond, gpointer data);
+    static gboolean onWritable(gint fd, GIOCondition cond, gpointer data);
+    static gboolean onRequestExpired(gpointer data);
+    static gboolean onFeedRetry(gpointer data);
+
+    // Parse JSON list response into entries (single pass, no copies of the input)
+    std::vector<ClipboardEntry> parseListResponse(std::string_view json);
 
-    // Parse JSON list response into entries
-    std::vector<ClipboardEntry> parseListResponse(const std::string& json);
+    static constexpr guint REQUEST_TIMEOUT_S = 5;  // matching clipman-client.py
+    static constexpr guint FEED_RETRY_MS = 2000;    // resubscribe while the daemon is away
 };
 
 } // namespace hyprclipx
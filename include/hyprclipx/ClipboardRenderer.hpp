@@ -5,11 +5,21 @@
 #include "Forward.hpp"
 #include "Config.hpp"
 #include "ClipboardEntry.hpp"
+#include "ListCache.hpp"
+#include "HistoryModel.hpp"
+#include "LatencyStats.hpp"
+#include "ThumbnailCache.hpp"
+#include "UIMessage.hpp"
+#include "WindowClassifier.hpp"
 #include <gtk/gtk.h>
 #include <gtk4-layer-shell.h>
+#include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 #include <atomic>
+#include <cstdint>
 
 namespace hyprclipx {
 
@@ -19,21 +29,28 @@ public:
     ~ClipboardRenderer();
 
     void initialize();
-    void show();
+    // `request` as sent by the plugin: hotkey time (for the hotkey → first
+    // frame latency), caret and monitor to place the window at
+    void show(const UIMessage& request = {});
     void hide();
-    void toggle();
+    void toggle(const UIMessage& request = {});
     bool isVisible() const;
     void setOffset(int x, int y);
     void refresh();
 
+    // Runtime counters as a JSON object (served by `hyprclipx-ui --stats`)
+    std::string stats() const;
+
 private:
     Config& m_config;
     ClipboardManager& m_manager;
+    WindowClassifier m_classifier;  // paste strategy per target window
+    // Cleared on destruction; paste workers check it before calling back
+    std::shared_ptr<bool> m_alive = std::make_shared<bool>(true);
 
     // GTK widgets
     GtkWidget* m_window       = nullptr;
-    GtkWidget* m_listBox      = nullptr;
-    GtkWidget* m_favBox       = nullptr;
+    GtkWidget* m_listView     = nullptr;
     GtkWidget* m_searchEntry  = nullptr;
     GtkWidget* m_scrolled     = nullptr;
     GtkWidget* m_offsetLabel  = nullptr;
@@ -43,13 +60,47 @@ private:
     // State
     std::string m_filter = "all";
     std::string m_search;
-    std::vector<ClipboardEntry> m_items;
-    int m_selectedIndex = 0;
+    std::vector<ClipboardEntry> m_items;   // rows of the list view, in order
+    GListModel* m_listModel = nullptr;    // m_items as the list view sees it
+    std::vector<GtkListItem*> m_boundRows;  // row widgets currently showing an entry
+    uint64_t m_listRequest = 0;   // in-flight list request (0 = none)
+    ListCache m_listCache;        // used while the change feed is down
+    HistoryModel m_history;       // mirror kept live by the change feed
+    ThumbnailCache m_thumbnails;  // decoded image row thumbnails, by uuid
+
+    // What the rows on screen are the result of
+    struct ShownView {
+        std::string filter, search;
+        int limit = 0;                // rows asked for so far (grows page by page)
+        uint64_t generation = 0;      // 0 = unknown, or pages read at different ones
+        bool complete = false;        // no further page
+        std::string nextCursor;       // daemon cursor of the next page ("" = local / none)
+    } m_shown;
+
+    uint64_t m_pageRequest = 0;   // in-flight next-page request (0 = none)
+
+    // Type-ahead search
+    guint m_searchDebounce = 0;       // coalescing timer
+    gint64 m_searchKeyTime = 0;       // oldest keystroke not rendered yet (µs)
+    gint64 m_searchRenderKeyTime = 0; // keystroke the next frame answers
+    guint m_searchTick = 0;
+    LatencyStats m_searchLatency;
+
+    // Hidden window: the next view is prepared on idle, so showing only maps
+    guint m_prewarmIdle = 0;
+    UIMessage m_showRequest;       // what the window is (being) shown for
+    gint64 m_showRequestTime = 0;  // hotkey press the next first frame answers
+    LatencyStats m_showLatency;
+    uint64_t m_shows = 0;
+    uint64_t m_showsPrepared = 0;  // shows whose rows were already current
+
+    int m_selectedIndex = 0;      // cursor row
+    int m_anchorIndex   = 0;      // other end of a Shift+arrow range (== cursor: one row)
     int m_filterIndex   = 0;
     std::atomic<bool> m_visible{false};
-    std::string m_previousWindowAddress;
 
     // UI assembly
+    void subscribeHistory();
     void buildUI();
     GtkWidget* createSidebarHeader();
     GtkWidget* createSidebarBody();
@@ -57,41 +108,66 @@ private:
     GtkWidget* createHintBar();
 
     // List management
-    void updateList();
-    void updateSelection(int newIndex);
+    void updateList(std::optional<std::vector<ClipboardEntry>> narrowed = std::nullopt);
+    void resetView();
+    void schedulePrewarm();
+    bool viewIsCurrent() const;
+    void scheduleSearch();
+    bool viewsLocally() const;
+    std::optional<std::vector<ClipboardEntry>> narrowedRows() const;
+    uint64_t currentGeneration() const;
+    void showItems(std::vector<ClipboardEntry> items, ShownView view);
+    void setRows(std::vector<ClipboardEntry> items);
+    void appendRows(const std::vector<ClipboardEntry>& rows);
+    void loadMore();
+    void finishList();
+    void applyLocalChanges(const std::vector<HistoryChange>& changes, uint64_t generation);
+    void updateSelection(int newIndex, bool extend = false);
+    void setSelection(int anchor, int cursor);
+    void styleRow(GtkListItem* row);
+    std::pair<int, int> selectionRange() const;
+    std::vector<std::string> selectedUuids() const;
     void updateFilterIcons();
     void scrollToIndex(int index);
     void updateOffsetOverlay();
 
-    // Smart paste (1:1 from AGS)
-    void pasteItem(const std::string& uuid, const std::string& itemType);
+    // List rows (GtkSignalListItemFactory)
+    struct RowWidgets;
+    static RowWidgets* rowWidgets(GtkListItem* row);
+    static void onRowSetup(GtkSignalListItemFactory*, GObject* row, gpointer);
+    static void onRowBind(GtkSignalListItemFactory*, GObject* row, gpointer self);
+    static void onRowUnbind(GtkSignalListItemFactory*, GObject* row, gpointer self);
+
+    // Smart paste (1:1 from AGS); several text items are joined by newlines
+    void pasteItems(std::vector<std::string> uuids, const std::string& itemType);
 
     // Window helpers
     void repositionWindow();
     void loadCaretOffset();
     void saveCaretOffset();
 
-    // Window detection (1:1 from AGS)
-    struct WindowInfo {
-        std::string windowClass, initialClass, title, initialTitle, address;
-        int pid = 0;
-        bool xwayland = false;
-    };
-    WindowInfo getActiveWindowInfo();
-    bool isTerminal(const WindowInfo& win);
-    bool isKittyTerminal(const WindowInfo& win);
-    bool isBrowser(const WindowInfo& win);
+    // Paste target: the show request's window snapshot, classified by
+    // m_classifier. Both run on paste worker threads, which never touch the
+    // renderer itself.
+    static UIWindow getActiveWindowInfo();  // shown without one
+    static void sendPasteKeys(PasteStrategy strategy, bool xwayland, const std::string& itemType);
 
     // Keyboard handler
     static gboolean onKeyPress(GtkEventControllerKey*, guint, guint,
                                GdkModifierType, gpointer);
 
     // Helpers
-    void removeAllChildren(GtkWidget* box);
-    std::string exec(const std::string& cmd);
+    static std::string exec(const std::string& cmd);
 
     static constexpr int ITEM_HEIGHT  = 28;
     static constexpr int OFFSET_STEP  = 20;
+    static constexpr int THUMB_WIDTH  = 30;   // daemon thumbnails are at most 100x65
+    static constexpr int THUMB_HEIGHT = 20;
+    static constexpr guint SEARCH_DEBOUNCE_MS  = 40;
+    static constexpr gint64 SEARCH_MAX_DELAY_MS = 120;
+    static constexpr int PREFETCH_ROWS = 10;  // next page once this close to the end
+    static constexpr int FOCUS_TIMEOUT_MS = 300;  // paste: wait for the refocus event
+    static constexpr int FOCUS_SETTLE_MS  = 150;  // no event socket: fixed wait instead
 };
 
 } // namespace hyprclipx
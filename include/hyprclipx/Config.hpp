@@ -1,8 +1,21 @@
 #pragma once
 #include <string>
+#include <vector>
 
 namespace hyprclipx {
 
+// [[paste_rule]] table in hyprclipx.toml (see WindowClassifier.hpp).
+// Each list matches if any of its patterns occurs; the rule, if all of its
+// lists (and xwayland, when set) match.
+struct PasteRule {
+    std::vector<std::string> classes;  // class / initialClass
+    std::vector<std::string> titles;   // title / initialTitle
+    std::vector<std::string> comms;    // process name
+    std::vector<std::string> any;      // any of the above
+    int xwayland = -1;                 // -1: either
+    std::string paste;                 // "terminal", "kitty", "browser", "default"
+};
+
 struct Config {
     // Window dimensions (compact horizontal layout)
     int windowWidth = 600;
@@ -13,16 +26,22 @@ struct Config {
     int offsetY = 0;
 
     // Behavior
-    int maxItems = 50;
+    int maxItems = 50;            // list page size; more load on scroll
     std::string hotkey = "SUPER V";
+    // "full": substring match on the full text, in the daemon; "fuzzy":
+    // rank previews in the UI as you type (previews only)
+    std::string searchMode = "full";
+    // Paste strategy per app, before the built-in detection
+    std::vector<PasteRule> pasteRules;
 
     // Paths
     std::string clipmanClient;    // path to clipman-client.py
     std::string caretHelper;      // path to get-caret-position.py
     std::string userSettingsFile;  // path to user-settings.json
-    std::string caretPosFile = "/tmp/clipboard-manager-caret-pos";
-    std::string prevWindowFile = "/tmp/clipboard-manager-prev-window";
     std::string socketPath = "/tmp/clipman.sock";
+    std::string selectionSocket = "/tmp/hyprclipx-selection.sock";  // plugin → daemon
+    std::string uiSocket = "/tmp/hyprclipx-ui.sock";                // plugin / CLI → UI
+    std::string caretSocket = "/tmp/hyprclipx-caret.sock";          // plugin → caret-daemon
 };
 
 } // namespace hyprclipx
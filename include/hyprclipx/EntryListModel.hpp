@@ -0,0 +1,32 @@
+#pragma once
+// GListModel over the rows on screen, for the UI's GtkListView. The entries
+// stay in a vector owned by the renderer; the model hands out an item
+// object (carrying a copy of its entry) only when the list view asks for
+// one, i.e. for the visible rows and a little overscan. Widget and object
+// count stay flat however long the list is.
+
+#include "ClipboardEntry.hpp"
+#include <gio/gio.h>
+#include <vector>
+
+namespace hyprclipx {
+
+// Model over `*items`, which must outlive it
+GListModel* entryListModelNew(const std::vector<ClipboardEntry>* items);
+
+// The vector changed: `removed` rows at `position` were replaced by `added`
+// new ones (emits items-changed)
+void entryListModelChanged(GListModel* model, guint position, guint removed, guint added);
+
+// Turns `items` (the model's vector) into `next`, keyed by uuid: removals,
+// insertions (a moved row counts as both) and rows whose fields changed are
+// applied and announced one run at a time. Rows that are unchanged keep
+// their item objects, so the list view keeps their widgets and doesn't
+// rebind them.
+void entryListModelReconcile(GListModel* model, std::vector<ClipboardEntry>& items,
+                             std::vector<ClipboardEntry> next);
+
+// Entry carried by an item of the model
+const ClipboardEntry& entryListItemEntry(gpointer item);
+
+} // namespace hyprclipx
@@ -0,0 +1,121 @@
+#pragma once
+// Immutable, columnar clipboard history for the UI's resident model.
+// One row per entry: 128-bit binary uuid, type/favorite flags, 32-bit epoch
+// timestamp and the end of its preview; previews sit back to back in one
+// arena. Thumbnails (images only) are kept aside with interned directories.
+// A handful of allocations per store instead of several per entry, and 25
+// bytes of fixed overhead per row instead of ~200 — what is left is mostly
+// the preview text itself.
+// Stores are published as shared_ptr<const EntryStore>: a refresh builds the
+// next one and swaps the pointer, readers keep whatever snapshot they hold.
+
+#include "ClipboardEntry.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hyprclipx {
+
+enum class EntryType : uint8_t { Text, Image };
+
+// Canonical 8-4-4-4-12 hex uuid, as the daemon's uuid4() produces
+struct Uuid {
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+
+    static std::optional<Uuid> parse(std::string_view text);
+    std::string toString() const;  // lowercase, canonical form
+
+    bool operator==(const Uuid&) const = default;
+};
+
+class EntryStore {
+public:
+    // Collects rows (newest first) for one store
+    class Builder {
+    public:
+        Builder();
+
+        // `thumbs` / `extraBytes`: thumbnails and the bytes of their names
+        void reserve(size_t rows, size_t arenaBytes, size_t thumbs = 0, size_t extraBytes = 0);
+        void append(const ClipboardEntry& entry);
+        // Copies row `row` of `from`; `favorite` overrides its flag if set
+        void appendRow(const EntryStore& from, size_t row,
+                       std::optional<bool> favorite = std::nullopt);
+        size_t size() const;
+
+        // Publishes the rows collected so far and starts over empty
+        std::shared_ptr<const EntryStore> build();
+
+    private:
+        std::shared_ptr<EntryStore> m_store;
+    };
+
+    static std::shared_ptr<const EntryStore> empty();
+
+    size_t size() const { return m_ids.size(); }
+
+    std::string uuid(size_t row) const;
+    EntryType type(size_t row) const;
+    bool favorite(size_t row) const;
+    std::string_view preview(size_t row) const;
+    std::string thumb(size_t row) const;     // full path, "" if none
+    int64_t createdAt(size_t row) const;     // Unix seconds (UTC), 0 if unknown
+    ClipboardEntry entry(size_t row) const;  // materialized copy
+
+    // Row index of `uuid`, if present
+    std::optional<size_t> find(std::string_view uuid) const;
+
+    // Next store: `changes` applied in commit order (same semantics as
+    // applyChanges() — inserts and updates land on top)
+    std::shared_ptr<const EntryStore> withChanges(const std::vector<HistoryChange>& changes) const;
+
+    // Heap bytes held by this store
+    size_t memoryUsage() const;
+
+private:
+    EntryStore() = default;
+
+    struct Span {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    enum Flags : uint8_t {
+        IMAGE    = 1 << 0,
+        FAVORITE = 1 << 1,
+        RAW_ID   = 1 << 2,  // uuid not canonical: kept verbatim, m_ids holds its span
+        THUMB    = 1 << 3,  // has a thumbnail in m_thumbs
+        FULL     = 1 << 4,  // preview is the whole searchable text
+    };
+
+    struct Thumb {
+        uint32_t row;
+        uint32_t dir;      // index into m_dirs
+        Span name;         // file name within the directory, in m_extra
+    };
+
+    std::vector<Uuid> m_ids;
+    std::vector<uint8_t> m_flags;
+    std::vector<uint32_t> m_created;      // Unix seconds, 0 = unknown
+    std::vector<uint32_t> m_previewEnds;  // a row's preview starts where the last one ended
+    std::string m_arena;                  // previews, in row order
+    std::string m_extra;                  // thumbnail names, non-canonical uuids
+    std::vector<Thumb> m_thumbs;          // by row
+    std::vector<std::string> m_dirs;      // interned thumbnail directories
+
+    Span storeExtra(std::string_view text);
+    std::string_view extra(Span span) const;
+    std::string_view rawId(size_t row) const;
+    const Thumb* thumbOf(size_t row) const;
+    uint32_t internDir(std::string_view dir);
+    void pushRow(Uuid id, uint8_t flags, uint32_t created, std::string_view preview);
+    void pushThumb(std::string_view dir, std::string_view name);
+    void shrink();
+};
+
+} // namespace hyprclipx
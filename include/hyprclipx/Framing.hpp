@@ -0,0 +1,34 @@
+#pragma once
+// Length-prefixed framing for the clipman-daemon socket
+// Frame = 4-byte big-endian payload length + UTF-8 JSON payload
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace hyprclipx {
+
+// Upper bound for a single frame; the daemon chunks large replies well below it
+inline constexpr size_t MAX_FRAME_SIZE = 16 * 1024 * 1024;
+
+std::string encodeFrame(std::string_view payload);
+
+// Incremental decoder: feed whatever recv() returned, pop complete frames.
+// Buffers at most one partial frame plus the last read.
+class FrameDecoder {
+public:
+    // Returns false on a corrupt stream (frame larger than MAX_FRAME_SIZE)
+    bool feed(const char* data, size_t len);
+
+    // Moves the next complete payload into `payload`; false if none yet
+    bool next(std::string& payload);
+
+    void reset();
+
+private:
+    std::string m_buf;
+    size_t m_pos = 0;  // start of the first unconsumed byte in m_buf
+};
+
+} // namespace hyprclipx
@@ -0,0 +1,43 @@
+#pragma once
+// fzf-style fuzzy matching for the UI's in-process search. Pattern characters
+// must appear in order, gaps allowed; the score rewards consecutive runs and
+// matches at word boundaries / camelCase humps, and penalizes gaps. The
+// character scans run with AVX2 / SSE4.2 when the CPU has them (picked once
+// at startup), the scoring pass only walks the matched window.
+// Case-insensitive over Unicode (simple one-to-one case folding).
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hyprclipx {
+
+class FuzzyMatcher {
+public:
+    explicit FuzzyMatcher(std::string_view pattern);
+
+    bool empty() const { return m_pattern.empty(); }
+
+    // Score of the best match of the pattern in `text` (higher is better),
+    // nullopt if it doesn't match. `positions` gets the byte offsets of the
+    // matched characters, ascending.
+    std::optional<int> match(std::string_view text,
+                             std::vector<uint32_t>* positions = nullptr) const;
+
+    // Instruction set of the character scans: "avx2", "sse4.2" or "scalar"
+    static const char* isa();
+    // Benchmarks: scan with `isa` instead, if this CPU supports it
+    static bool setIsa(std::string_view isa);
+
+private:
+    std::u32string m_pattern;  // case-folded
+    bool m_ascii = true;       // whole pattern is ASCII: match on bytes directly
+};
+
+// Simple case folding (one code point to one) for Latin, Greek, Cyrillic,
+// Armenian and fullwidth forms; anything else folds to itself
+char32_t foldCase(char32_t c);
+
+} // namespace hyprclipx
@@ -14,8 +14,9 @@ void initGlobals();
 void cleanupGlobals();
 void reloadConfig();
 
-// Capture caret/window using Hyprland APIs, then fork+exec UI command
-// (Matching ags-toggle-clipboard.template: capture BEFORE opening window)
+// Capture window/monitor now and the caret on the worker, then send the
+// command to the UI (matching ags-toggle-clipboard.template: capture BEFORE
+// opening window)
 void captureAndSendUI(const std::string& cmd);
 
 // Send command to UI without caret capture (e.g., hide)
@@ -0,0 +1,53 @@
+#pragma once
+// In-memory mirror of the daemon's clipboard history, kept current by the
+// change feed (ClipboardManager::subscribe). Views (filter / search / limit)
+// are derived locally, so showing the window never waits on the daemon.
+
+#include "ClipboardEntry.hpp"
+#include "EntryStore.hpp"
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace hyprclipx {
+
+class HistoryModel {
+public:
+    // True while the feed is live; otherwise the contents may be outdated
+    bool synced() const { return m_synced; }
+    // Generation the contents correspond to (kept across feed loss, so a
+    // reconnect only needs the changes since then)
+    uint64_t generation() const { return m_generation; }
+    // Current contents (newest first); a later change publishes a new store
+    // and leaves this one untouched
+    std::shared_ptr<const EntryStore> snapshot() const { return m_store; }
+    size_t size() const { return m_store->size(); }
+
+    // Replaces everything with a full snapshot
+    void reset(std::shared_ptr<const EntryStore> store, uint64_t generation);
+    // Applies changes committed up to `generation` (already seen ones are
+    // skipped) and marks the model synced
+    void apply(const std::vector<HistoryChange>& changes, uint64_t generation);
+    // Feed lost: contents stay, but may miss changes until the next sync
+    void invalidate() { m_synced = false; }
+
+    // Filter as the daemon's "list" does: "all" / "favorites" / "text" /
+    // "image", newest first. A non-empty search fuzzy-matches the previews
+    // instead (FuzzyMatcher): best score first, ties newest first, with the
+    // matched characters in each entry's `highlight`.
+    // Skips the first `offset` matches; `more` is set if matches remain. Only
+    // the returned rows are materialized.
+    std::vector<ClipboardEntry> query(std::string_view filter, std::string_view search,
+                                      int limit, int offset = 0, bool* more = nullptr) const;
+
+private:
+    std::shared_ptr<const EntryStore> m_store = EntryStore::empty();
+    uint64_t m_generation = 0;
+    bool m_synced = false;
+};
+
+// Applies feed changes to a newest-first list (inserts / updates go on top)
+void applyChanges(std::vector<ClipboardEntry>& items, const std::vector<HistoryChange>& changes);
+
+} // namespace hyprclipx
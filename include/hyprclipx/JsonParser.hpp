@@ -0,0 +1,52 @@
+#pragma once
+// Single-pass JSON reader for clipman-daemon replies (and the plugin's
+// commands to the UI)
+// Scans a std::string_view once; strings are decoded straight into their
+// destination (full escape support incl. \uXXXX surrogate pairs)
+
+#include "ClipboardEntry.hpp"
+#include "UIMessage.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hyprclipx {
+
+// Top-level fields every daemon reply frame carries
+struct ReplyEnvelope {
+    uint64_t id = 0;        // request id (0 = none / unsolicited)
+    bool ok = false;        // "status": "ok"
+    bool more = false;      // streamed reply, further frames follow
+    std::string error;      // "error" message when !ok
+    uint64_t generation = 0;  // daemon history generation (0 = not reported)
+    std::string event;      // unsolicited frames: event name
+    bool resync = false;    // subscribe reply carries a full snapshot
+    std::string nextCursor; // list reply: cursor of the following page ("" = last)
+};
+
+// Reads only the envelope. The daemon writes it ahead of "data" / "changes",
+// so this stops as soon as the payload starts. Returns false on malformed input.
+bool parseReplyEnvelope(std::string_view json, ReplyEnvelope& env);
+
+// Parses a (possibly chunked) list reply, appending entries to `out`.
+// Returns false on malformed input; entries parsed up to that point stay.
+bool parseListReply(std::string_view json, std::vector<ClipboardEntry>& out,
+                    ReplyEnvelope* env = nullptr);
+
+// Parses the "changes" array of a change push or subscribe delta, appending
+// to `out`. Changes with an unknown "op" are skipped.
+bool parseChangeList(std::string_view json, std::vector<HistoryChange>& out,
+                     ReplyEnvelope* env = nullptr);
+
+// Parses one line of the UI socket. Returns false on malformed input or a
+// missing "cmd".
+bool parseUIMessage(std::string_view json, UIMessage& out);
+
+// Decodes the body of a JSON string literal (without quotes) into `out`
+bool unescapeJsonString(std::string_view raw, std::string& out);
+
+// Escapes `in` for embedding inside a JSON string literal
+std::string escapeJsonString(std::string_view in);
+
+} // namespace hyprclipx
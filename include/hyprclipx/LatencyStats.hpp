@@ -0,0 +1,32 @@
+#pragma once
+// Rolling latency samples with a percentile summary (for `hyprclipx-ui --stats`)
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hyprclipx {
+
+class LatencyStats {
+public:
+    void record(int64_t us);
+
+    uint64_t count() const { return m_count; }
+    // Percentile (0..100) over the most recent WINDOW samples, in µs
+    int64_t percentile(double p) const;
+
+    // {"count":N,"last_ms":..,"p50_ms":..,"p95_ms":..,"max_ms":..}
+    std::string toJson() const;
+
+private:
+    static constexpr size_t WINDOW = 256;
+
+    std::array<int64_t, WINDOW> m_samples{};
+    size_t m_next = 0;
+    uint64_t m_count = 0;
+    int64_t m_last = 0;
+    int64_t m_max = 0;
+};
+
+} // namespace hyprclipx
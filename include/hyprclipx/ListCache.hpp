@@ -0,0 +1,54 @@
+#pragma once
+// Client-side cache of list results, validated by the daemon's history
+// generation. The daemon bumps the generation on every change and pushes it
+// to connected clients, so a result read at the current generation is still
+// exact — reopening the window or toggling back to a filter needs no IPC.
+
+#include "ClipboardEntry.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hyprclipx {
+
+class ListCache {
+public:
+    struct Key {
+        std::string filter;
+        std::string search;
+        int limit = 0;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    // Cached first page for `key` if it was read at `generation`, else
+    // nullptr. Generation 0 (unknown, e.g. disconnected) never hits.
+    const ListPage* lookup(const Key& key, uint64_t generation);
+
+    // Remembers a page read at page.generation; older results are dropped
+    void store(Key key, ListPage page);
+
+    void clear();
+
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+    size_t size() const { return m_slots.size(); }
+
+private:
+    struct Slot {
+        Key key;
+        uint64_t lastUsed = 0;
+        ListPage page;
+    };
+
+    // A handful of filter/search combinations at most; linear scan is fine
+    std::vector<Slot> m_slots;
+    uint64_t m_tick = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+
+    static constexpr size_t MAX_SLOTS = 16;
+};
+
+} // namespace hyprclipx
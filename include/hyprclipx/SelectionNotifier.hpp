@@ -0,0 +1,17 @@
+#pragma once
+// Clipboard selection events from inside the compositor (plugin side).
+// clipman-daemon connects to the socket and captures once per copy instead
+// of polling wl-paste. Line-delimited JSON, one line per selection change:
+//   {"event":"selection","mime_types":["text/plain;charset=utf-8",...]}
+// A client gets the current selection right after connecting. Runs on the
+// compositor's event loop: non-blocking sockets, no threads.
+
+#include <string>
+
+namespace hyprclipx {
+
+// Listens on `socketPath` and hooks the seat's selection changes
+bool startSelectionNotifier(const std::string& socketPath);
+void stopSelectionNotifier();
+
+} // namespace hyprclipx
@@ -0,0 +1,70 @@
+#pragma once
+// Thumbnails for image rows. The daemon's thumbnail PNGs are decoded into
+// GdkTextures on a small worker pool and kept in a byte-bounded LRU keyed by
+// entry uuid, so scrolling back or reopening the window never decodes again.
+// A row hands over a GtkPicture as placeholder; it gets the texture at once
+// when cached, else when its decode finishes (unless the row was recycled
+// for another entry by then). Used from the main thread only — the workers
+// just decode and post the result back.
+
+#include <gtk/gtk.h>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hyprclipx {
+
+class ThumbnailCache {
+public:
+    static constexpr size_t DEFAULT_MAX_BYTES = 16 * 1024 * 1024;  // ~600 daemon thumbnails
+    static constexpr int DECODE_THREADS = 2;
+
+    explicit ThumbnailCache(size_t maxBytes = DEFAULT_MAX_BYTES);
+    ~ThumbnailCache();
+
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+    // Shows the thumbnail of `uuid` (PNG at `path`) in `picture`. A picture
+    // waiting for a decode is kept alive until it is done; if it was reused
+    // for another entry meanwhile, the late texture is not applied.
+    void show(const std::string& uuid, const std::string& path, GtkPicture* picture);
+    // Empties a (recycled) picture and cancels what it was waiting for
+    static void clear(GtkPicture* picture);
+
+    size_t bytes() const { return m_bytes; }
+    size_t size() const { return m_slots.size(); }
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+    uint64_t decodes() const { return m_decodes; }
+
+private:
+    struct Slot {
+        GdkTexture* texture = nullptr;  // nullptr: file missing / not decodable
+        size_t bytes = 0;
+        std::list<std::string>::iterator lru;
+    };
+
+    std::unordered_map<std::string, Slot> m_slots;
+    std::list<std::string> m_lru;  // most recently shown first
+    // Pictures waiting for a decode in flight, by uuid
+    std::unordered_map<std::string, std::vector<GtkPicture*>> m_pending;
+    GThreadPool* m_pool = nullptr;
+    // Shared with decode results in flight (main thread only)
+    std::shared_ptr<bool> m_alive;
+    size_t m_maxBytes;
+    size_t m_bytes = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_decodes = 0;
+
+    static void decode(gpointer job, gpointer self);
+    void finish(const std::string& uuid, GdkTexture* texture);
+    void evict();
+};
+
+} // namespace hyprclipx
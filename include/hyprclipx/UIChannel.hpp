@@ -0,0 +1,20 @@
+#pragma once
+// Persistent connection to hyprclipx-ui's socket (plugin side). A hotkey
+// writes one UIMessage line to the resident UI instead of forking the
+// compositor to run the CLI. Runs on the compositor's event loop:
+// non-blocking socket, nothing ever waits. While the UI isn't running,
+// messages queue up, the UI is spawned (once) and the connection retried
+// until it listens.
+
+#include <string>
+
+namespace hyprclipx {
+
+bool startUIChannel(const std::string& socketPath);
+void stopUIChannel();
+
+// Queues one encoded UIMessage (see UIMessage.hpp) and sends it as soon as
+// the UI takes it
+void sendToUI(std::string line);
+
+} // namespace hyprclipx
@@ -0,0 +1,40 @@
+#pragma once
+// Commands for hyprclipx-ui, sent over its socket by the plugin (one
+// persistent connection, a line per hotkey) or by the CLI (one line, then
+// close). One JSON object per line:
+//   {"cmd":"show","since":81234567890,"caret":[x,y],"monitor":[x,y,w,h],
+//    "window":{"address":"0x…","class":"kitty","initialClass":"kitty",
+//              "title":"~","initialTitle":"kitty","pid":4242,"xwayland":false}}
+// `since` is the hotkey press in CLOCK_MONOTONIC µs; caret and monitor are
+// in Hyprland's logical coordinates; window is the one focused at the
+// hotkey, with hyprctl activewindow's keys. Fields that aren't known are
+// left out.
+
+#include <cstdint>
+#include <string>
+
+namespace hyprclipx {
+
+// The window focused at the hotkey: where a paste goes and how to send it
+struct UIWindow {
+    std::string address;            // "0x…", for focuswindow
+    std::string windowClass, initialClass, title, initialTitle;
+    int pid = 0;
+    bool xwayland = false;
+};
+
+struct UIMessage {
+    std::string cmd;          // "show", "hide", "toggle" or "stats"
+    int64_t since = 0;        // 0 = unknown
+    bool hasCaret = false;
+    int caretX = 0, caretY = 0;
+    bool hasMonitor = false;
+    int monX = 0, monY = 0, monW = 0, monH = 0;
+    bool hasWindow = false;
+    UIWindow window;
+};
+
+// The message as one line, '\n' included (parsing: parseUIMessage, JsonParser.hpp)
+std::string encodeUIMessage(const UIMessage& msg);
+
+} // namespace hyprclipx
@@ -0,0 +1,96 @@
+#pragma once
+// Paste strategy for the target window. Rules match substrings of the
+// window's class, title and process name (/proc/<pid>/comm), case-insensitive
+// (ASCII), `^` / `$` anchoring a pattern at the start / end; optionally its
+// XWayland flag. The first rule that matches decides: those from
+// [[paste_rule]] tables in hyprclipx.toml, then the built-in ones (1:1 from
+// AGS). All patterns are compiled into one Aho-Corasick automaton, so a
+// window costs one pass over each of its strings however many rules there
+// are; the class and process name results are kept per (class, pid).
+
+#include "Config.hpp"
+#include "UIMessage.hpp"
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace hyprclipx {
+
+enum class PasteStrategy { Default, Terminal, Kitty, Browser };
+
+// "default", "terminal", "kitty", "browser"
+std::optional<PasteStrategy> parsePasteStrategy(std::string_view name);
+const char* pasteStrategyName(PasteStrategy strategy);
+
+// Aho-Corasick automaton over a fixed set of patterns, as a dense DFA on
+// the byte classes the patterns use. ASCII case-insensitive; the text is
+// scanned between ANCHOR_START and ANCHOR_END, so patterns can pin
+// themselves to either end.
+class PatternSet {
+public:
+    static constexpr char ANCHOR_START = '\x02';
+    static constexpr char ANCHOR_END   = '\x03';
+
+    explicit PatternSet(const std::vector<std::string>& patterns);
+
+    size_t size() const { return m_patterns; }
+    // Words of a hit set: bit i set = pattern i occurs
+    size_t words() const { return m_words; }
+
+    // ORs the patterns occurring in `text` into `hits` (words() long)
+    void scan(std::string_view text, uint64_t* hits) const;
+
+private:
+    size_t m_patterns = 0;
+    size_t m_words = 1;
+    size_t m_classes = 1;                // byte classes; 0 = in no pattern
+    uint8_t m_classOf[256] = {};         // case-folded byte → class
+    std::vector<int32_t> m_next;         // state * m_classes + class → state
+    std::vector<uint64_t> m_out;         // state * m_words: patterns ending here
+    std::vector<uint8_t> m_hasOut;
+};
+
+class WindowClassifier {
+public:
+    explicit WindowClassifier(const std::vector<PasteRule>& userRules);
+
+    // Safe to call from several threads
+    PasteStrategy classify(const UIWindow& win);
+
+    // Memoized (class, pid) results
+    size_t cached() const;
+
+private:
+    enum Field : uint8_t { Class, InitialClass, Title, InitialTitle, Comm, FIELD_COUNT };
+
+    struct Condition {
+        uint8_t fields;                  // 1 << Field, any of them
+        std::vector<uint32_t> patterns;  // any of them
+    };
+    struct Rule {
+        std::vector<Condition> conditions;  // all of them
+        int xwayland = -1;
+        PasteStrategy strategy = PasteStrategy::Default;
+    };
+
+    void addRule(std::vector<std::pair<uint8_t, std::vector<std::string>>> conditions,
+                 int xwayland, PasteStrategy strategy);
+    bool hit(const std::vector<uint64_t>& hits, Field field, uint32_t pattern) const;
+
+    std::vector<Rule> m_rules;
+    std::vector<std::string> m_patternList;
+    std::unordered_map<std::string, uint32_t> m_patternIds;
+    std::optional<PatternSet> m_patterns;  // built once all rules are in
+    bool m_needsComm = false;
+
+    // (class, pid) → hits of the class and process name fields
+    static constexpr size_t MAX_CACHED = 256;
+    std::unordered_map<std::string, std::vector<uint64_t>> m_cache;
+    mutable std::mutex m_cacheMutex;
+};
+
+} // namespace hyprclipx
@@ -0,0 +1,240 @@
+// Caret lookup on a worker thread (see CaretLocator.hpp)
+// Plugin side - NO GTK. The worker only talks to caret-daemon and runs the
+// helper; queues and callbacks belong to the compositor thread, which it
+// wakes via an eventfd.
+
+#include "hyprclipx/CaretLocator.hpp"
+
+#include <hyprland/src/Compositor.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace hyprclipx {
+
+struct CaretJob {
+    CaretLookup lookup;
+    CaretCallback done;
+    std::optional<std::pair<int, int>> result;
+};
+
+static std::thread s_worker;
+static std::mutex s_mutex;
+static std::condition_variable s_wake;
+static std::deque<CaretJob> s_jobs;      // waiting for the worker
+static std::deque<CaretJob> s_finished;  // waiting for the compositor thread
+static bool s_stopping = false;
+static int s_eventFd = -1;
+static wl_event_source* s_eventSource = nullptr;
+
+// caret-daemon connection, worker thread only. A cache hit is answered in
+// well under a millisecond; a miss makes it search the app once, bounded by
+// its own AT-SPI timeout.
+static constexpr int SERVICE_TIMEOUT_MS = 400;
+static constexpr size_t MAX_REPLY = 256;
+static int s_serviceFd = -1;
+
+// ============================================================================
+// Worker side (blocking is fine here)
+// ============================================================================
+
+// Output of `cmd`, or "" if it failed
+static std::string run(const std::string& cmd) {
+    FILE* pipe = popen(cmd.c_str(), "r");
+    if (!pipe) return "";
+    char buf[256];
+    std::string result;
+    while (fgets(buf, sizeof(buf), pipe)) result += buf;
+    return pclose(pipe) == 0 ? result : "";
+}
+
+// {"x": 123, "y": 456} → (123, 456)
+static std::optional<std::pair<int, int>> parsePoint(const std::string& json) {
+    size_t xp = json.find("\"x\":");
+    size_t yp = json.find("\"y\":");
+    if (xp == std::string::npos || yp == std::string::npos) return std::nullopt;
+    int x = std::atoi(json.c_str() + xp + 4);
+    int y = std::atoi(json.c_str() + yp + 4);
+    if (x < 0 || y < 0) return std::nullopt;
+    return std::pair{x, y};
+}
+
+static void closeService() {
+    if (s_serviceFd != -1) {
+        close(s_serviceFd);
+        s_serviceFd = -1;
+    }
+}
+
+static bool connectService(const std::string& path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) return false;
+
+    timeval tv{SERVICE_TIMEOUT_MS / 1000, (SERVICE_TIMEOUT_MS % 1000) * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    struct sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == -1) {
+        close(fd);
+        return false;
+    }
+    s_serviceFd = fd;
+    return true;
+}
+
+// One request / reply on the open connection; "" if it failed
+static std::string roundTrip(const std::string& request, bool& timedOut) {
+    if (send(s_serviceFd, request.data(), request.size(), MSG_NOSIGNAL) !=
+        static_cast<ssize_t>(request.size()))
+        return "";
+    std::string reply;
+    char buf[128];
+    while (reply.find('\n') == std::string::npos && reply.size() < MAX_REPLY) {
+        ssize_t n = recv(s_serviceFd, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            timedOut = n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+            return "";
+        }
+        reply.append(buf, static_cast<size_t>(n));
+    }
+    return reply;
+}
+
+// Asks caret-daemon. False if it isn't reachable; `caret` stays empty when
+// it is, but knows no caret for the window.
+static bool queryService(const CaretLookup& l, std::optional<std::pair<int, int>>& caret) {
+    if (l.socket.empty()) return false;
+    std::string request = "{\"pid\":" + std::to_string(l.pid) + "}\n";
+
+    // The open connection, else a fresh one (also when the open one turns
+    // out to be dead, e.g. the service was restarted). A timeout means a
+    // busy service, not a dead connection: no second wait.
+    while (true) {
+        bool fresh = s_serviceFd == -1;
+        if (fresh && !connectService(l.socket)) return false;
+        bool timedOut = false;
+        std::string reply = roundTrip(request, timedOut);
+        if (!reply.empty()) {
+            caret = parsePoint(reply);
+            return true;
+        }
+        // A late reply would be taken for the next one's: start over
+        closeService();
+        if (fresh || timedOut) return false;
+    }
+}
+
+static std::optional<std::pair<int, int>> locate(const CaretLookup& l) {
+    // 1. Text-input caret from the compositor, else the AT-SPI caret: from
+    // caret-daemon's cache, else the one-shot helper (matching AGS
+    // get-caret-position.py)
+    std::optional<std::pair<int, int>> caret = l.known;
+    if (!caret && !queryService(l, caret))
+        caret = parsePoint(run("/usr/bin/python3 " + l.helper + " 2>/dev/null"));
+    if (caret) {
+        // AT-SPI can land slightly outside (physical vs logical pixels on
+        // multi-monitor setups with scaling)
+        caret->first = std::clamp(caret->first, l.monX, l.monX + l.monW - 1);
+        caret->second = std::clamp(caret->second, l.monY, l.monY + l.monH - 1);
+        return caret;
+    }
+    // 2. Mouse cursor
+    return l.cursor;
+}
+
+static void workerMain() {
+    std::unique_lock lock(s_mutex);
+    while (true) {
+        s_wake.wait(lock, [] { return s_stopping || !s_jobs.empty(); });
+        if (s_stopping) return;
+
+        CaretJob job = std::move(s_jobs.front());
+        s_jobs.pop_front();
+        lock.unlock();
+        job.result = locate(job.lookup);
+        lock.lock();
+
+        s_finished.push_back(std::move(job));
+        uint64_t one = 1;
+        (void)!write(s_eventFd, &one, sizeof(one));
+    }
+}
+
+// ============================================================================
+// Compositor side
+// ============================================================================
+
+static int onFinished(int fd, uint32_t, void*) {
+    uint64_t count;
+    (void)!read(fd, &count, sizeof(count));
+
+    std::deque<CaretJob> finished;
+    {
+        std::lock_guard lock(s_mutex);
+        finished.swap(s_finished);
+    }
+    for (auto& job : finished) job.done(job.result);
+    return 0;
+}
+
+bool startCaretLocator() {
+    stopCaretLocator();
+
+    s_eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (s_eventFd == -1) return false;
+    s_eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, s_eventFd,
+                                         WL_EVENT_READABLE, onFinished, nullptr);
+    s_stopping = false;
+    s_worker = std::thread(workerMain);
+    return true;
+}
+
+void stopCaretLocator() {
+    if (s_worker.joinable()) {
+        {
+            std::lock_guard lock(s_mutex);
+            s_stopping = true;
+        }
+        s_wake.notify_all();
+        s_worker.join();
+    }
+    closeService();
+    s_jobs.clear();
+    s_finished.clear();
+    if (s_eventSource) {
+        wl_event_source_remove(s_eventSource);
+        s_eventSource = nullptr;
+    }
+    if (s_eventFd != -1) {
+        close(s_eventFd);
+        s_eventFd = -1;
+    }
+}
+
+void locateCaret(CaretLookup lookup, CaretCallback done) {
+    if (!s_worker.joinable()) {
+        done(std::nullopt);
+        return;
+    }
+    {
+        std::lock_guard lock(s_mutex);
+        s_jobs.push_back({std::move(lookup), std::move(done), std::nullopt});
+    }
+    s_wake.notify_one();
+}
+
+} // namespace hyprclipx
@@ -1,203 +1,474 @@
-// IPC client for clipman-daemon via Unix socket
+// IPC client for clipman-daemon via a persistent Unix socket
 // Replaces AGS's execAsync("python3 clipman-client.py ...") calls
+// Non-blocking, driven by GLib fd watches — never blocks the GTK thread
 
 #include "hyprclipx/ClipboardManager.hpp"
+#include <glib-unix.h>
+#include <iterator>
+#include <memory>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
+#include <cerrno>
 #include <cstring>
 #include <algorithm>
 
 namespace hyprclipx {
 
+static bool isOk(const std::string& response);
+
+// Commands that only read, safe to send again after a reconnect
+static bool isIdempotent(const std::string& cmd) {
+    return cmd == "list" || cmd == "ping" || cmd == "subscribe";
+}
+
+// Timeout / deferred-failure source payload
+struct RequestSourceData {
+    ClipboardManager* self;
+    uint64_t id;
+};
+
+static void freeRequestSourceData(gpointer p) {
+    delete static_cast<RequestSourceData*>(p);
+}
+
 ClipboardManager::ClipboardManager(const Config& config)
     : m_config(config) {
 }
 
+ClipboardManager::~ClipboardManager() {
+    if (m_feedRetry) g_source_remove(m_feedRetry);
+    for (auto& [id, p] : m_pending)
+        if (p.timeoutSource) g_source_remove(p.timeoutSource);
+    m_pending.clear();
+    disconnect();
+}
+
 // ============================================================================
-// Unix Socket IPC (matching clipman-client.py send_command)
+// Unix Socket IPC — one persistent connection, requests tagged with an id
+// Wire format: "HCX2\n" preamble, then length-prefixed JSON frames each way
+// (see Framing.hpp). List replies are streamed as several frames carrying
+// "more": true, the last one "more": false.
 // ============================================================================
 
-std::string ClipboardManager::sendCommand(const std::string& cmd, const std::string& argsJson) {
-    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
-    if (sock == -1) return "";
+static constexpr const char* MUX_PREAMBLE = "HCX2\n";
+
+bool ClipboardManager::ensureConnected() {
+    if (m_sock != -1) return true;
+
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (sock == -1) return false;
 
     struct sockaddr_un addr{};
     addr.sun_family = AF_UNIX;
     strncpy(addr.sun_path, m_config.socketPath.c_str(), sizeof(addr.sun_path) - 1);
 
-    // Timeout (matching clipman-client.py: 5 seconds)
-    struct timeval tv{5, 0};
-    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-    setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
-
+    // AF_UNIX connects complete immediately or fail (ENOENT, ECONNREFUSED,
+    // EAGAIN on a full backlog) — nothing to wait for
     if (connect(sock, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == -1) {
         close(sock);
-        return "";
+        return false;
     }
 
-    // Send JSON request (matching clipman-client.py format)
-    std::string request = "{\"cmd\":\"" + cmd + "\",\"args\":" + argsJson + "}";
-    send(sock, request.c_str(), request.size(), 0);
+    m_sock = sock;
+    m_connSerial++;
+    m_outBuf = MUX_PREAMBLE;  // flushed ahead of the first request
+    m_readWatch = g_unix_fd_add(m_sock,
+        static_cast<GIOCondition>(G_IO_IN | G_IO_HUP | G_IO_ERR), onReadable, this);
+    return true;
+}
 
-    // Read response
-    char buf[65536];
-    ssize_t n = recv(sock, buf, sizeof(buf) - 1, 0);
-    close(sock);
+void ClipboardManager::disconnect() {
+    if (m_readWatch)  g_source_remove(m_readWatch);
+    if (m_writeWatch) g_source_remove(m_writeWatch);
+    m_readWatch = m_writeWatch = 0;
+    if (m_sock != -1) close(m_sock);
+    m_sock = -1;
+    m_decoder.reset();
+    m_outBuf.clear();
+    m_generation = 0;  // pushes may be missed until the daemon greets us again
+}
+
+// Daemon restarted or died: resend reads that have not been answered yet
+// (once), fail the rest. A mutation may have been committed before the
+// connection dropped even though no reply came back — running it again
+// would paste twice or flip a favorite back — so those are left to the
+// caller. Failures are reported from an idle callback.
+void ClipboardManager::onConnectionLost() {
+    disconnect();
+
+    // The subscription died with the connection; resubscribe on a fresh one
+    m_feedBacklog.clear();
+    if (m_feedLive) {
+        m_feedLive = false;
+        if (m_feed.onLost) m_feed.onLost();
+        scheduleFeedRetry(0);
+    }
+
+    std::vector<uint64_t> resend;
+    for (auto& [id, p] : m_pending) {
+        if (p.idempotent && !p.receivedAny && !p.resent) {
+            p.resent = true;
+            resend.push_back(id);
+        } else {
+            failLater(id);
+        }
+    }
+    if (resend.empty()) return;
 
-    if (n > 0) {
-        buf[n] = '\0';
-        return std::string(buf, static_cast<size_t>(n));
+    if (!ensureConnected()) {
+        for (uint64_t id : resend) failLater(id);
+        return;
     }
-    return "";
+    std::sort(resend.begin(), resend.end());  // keep submission order
+    for (uint64_t id : resend) {
+        auto it = m_pending.find(id);
+        if (it != m_pending.end()) m_outBuf += it->second.frame;
+    }
+    queueWrite({});
 }
 
-// ============================================================================
-// Daemon Commands
-// ============================================================================
+void ClipboardManager::queueWrite(std::string_view data) {
+    m_outBuf.append(data);
+    if (!flushWrites()) {
+        onConnectionLost();
+        return;
+    }
+    if (!m_outBuf.empty() && !m_writeWatch)
+        m_writeWatch = g_unix_fd_add(m_sock, G_IO_OUT, onWritable, this);
+}
+
+// Writes as much of m_outBuf as the socket takes; false on a hard error
+bool ClipboardManager::flushWrites() {
+    size_t off = 0;
+    while (off < m_outBuf.size()) {
+        ssize_t n = send(m_sock, m_outBuf.data() + off, m_outBuf.size() - off,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n <= 0) return false;
+        off += static_cast<size_t>(n);
+    }
+    m_outBuf.erase(0, off);
+    return true;
+}
+
+gboolean ClipboardManager::onWritable(gint, GIOCondition, gpointer data) {
+    auto* self = static_cast<ClipboardManager*>(data);
+    if (!self->flushWrites()) {
+        self->m_writeWatch = 0;  // removed by returning G_SOURCE_REMOVE below
+        self->onConnectionLost();
+        return G_SOURCE_REMOVE;
+    }
+    if (!self->m_outBuf.empty()) return G_SOURCE_CONTINUE;
+    self->m_writeWatch = 0;
+    return G_SOURCE_REMOVE;
+}
 
-std::vector<ClipboardEntry> ClipboardManager::fetchItems(const std::string& filter,
-                                                          const std::string& search,
-                                                          int limit) {
-    std::string args = "{\"filter\":\"" + filter + "\"";
-    if (!search.empty()) {
-        // Escape quotes in search
-        std::string escaped = search;
-        size_t pos = 0;
-        while ((pos = escaped.find('"', pos)) != std::string::npos) {
-            escaped.replace(pos, 1, "\\\"");
-            pos += 2;
+gboolean ClipboardManager::onReadable(gint, GIOCondition, gpointer data) {
+    auto* self = static_cast<ClipboardManager*>(data);
+    uint64_t serial = self->m_connSerial;
+
+    // Drain the socket, then dispatch whatever frames are complete
+    bool lost = false;
+    for (;;) {
+        char buf[65536];
+        ssize_t n = recv(self->m_sock, buf, sizeof(buf), MSG_DONTWAIT);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n <= 0 || !self->m_decoder.feed(buf, static_cast<size_t>(n))) {
+            lost = true;
+            break;
         }
-        args += ",\"search\":\"" + escaped + "\"";
     }
-    args += ",\"limit\":" + std::to_string(limit) + "}";
 
-    std::string response = sendCommand("list", args);
-    if (response.empty()) return {};
+    std::string frame;
+    while (self->m_connSerial == serial && self->m_decoder.next(frame))
+        self->handleFrame(frame);
 
-    return parseListResponse(response);
+    // A callback may already have replaced the connection; leave that one be
+    if (self->m_connSerial != serial) return G_SOURCE_REMOVE;
+    if (lost) {
+        self->m_readWatch = 0;  // removed by returning G_SOURCE_REMOVE below
+        self->onConnectionLost();
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
 }
 
-bool ClipboardManager::paste(const std::string& uuid) {
-    std::string args = "{\"uuid\":\"" + uuid + "\"}";
-    std::string response = sendCommand("paste", args);
-    return response.find("\"ok\"") != std::string::npos;
+void ClipboardManager::handleFrame(const std::string& frame) {
+    ReplyEnvelope env;
+    if (!parseReplyEnvelope(frame, env)) return;
+    if (env.id == 0) {
+        handleEvent(env, frame);
+        return;
+    }
+
+    auto it = m_pending.find(env.id);
+    if (it == m_pending.end()) return;  // cancelled
+
+    it->second.receivedAny = true;
+    // Copy: the callback may cancel its own request
+    FrameCallback onFrame = it->second.onFrame;
+    if (onFrame) onFrame(frame);
+    if (!env.more) finish(env.id, frame);
 }
 
-bool ClipboardManager::toggleFavorite(const std::string& uuid) {
-    std::string args = "{\"uuid\":\"" + uuid + "\"}";
-    std::string response = sendCommand("favorite", args);
-    return response.find("\"ok\"") != std::string::npos;
+// Unsolicited frames: the daemon greets each connection with its current
+// generation and pushes every change — just the new generation, or the
+// changes themselves ("change") once subscribed
+void ClipboardManager::handleEvent(const ReplyEnvelope& env, const std::string& frame) {
+    if (env.generation > m_generation) m_generation = env.generation;
+    if (env.event != "change" || !m_feedSince) return;
+
+    std::vector<HistoryChange> changes;
+    if (!parseChangeList(frame, changes)) return;
+    if (m_feedLive) {
+        if (m_feed.onChanges) m_feed.onChanges(changes, env.generation);
+    } else {
+        m_feedBacklog.emplace_back(env.generation, std::move(changes));
+    }
 }
 
-bool ClipboardManager::deleteItem(const std::string& uuid) {
-    std::string args = "{\"uuid\":\"" + uuid + "\"}";
-    std::string response = sendCommand("delete", args);
-    return response.find("\"ok\"") != std::string::npos;
+void ClipboardManager::finish(uint64_t id, const std::string& reply) {
+    auto it = m_pending.find(id);
+    if (it == m_pending.end()) return;
+    Pending p = std::move(it->second);
+    m_pending.erase(it);
+    if (p.timeoutSource) g_source_remove(p.timeoutSource);
+    if (p.onReply) p.onReply(reply);
 }
 
-bool ClipboardManager::clearAll() {
-    std::string response = sendCommand("clear");
-    return response.find("\"ok\"") != std::string::npos;
+gboolean ClipboardManager::onRequestExpired(gpointer data) {
+    auto* d = static_cast<RequestSourceData*>(data);
+    auto it = d->self->m_pending.find(d->id);
+    if (it != d->self->m_pending.end()) {
+        it->second.timeoutSource = 0;  // this source, removed on return
+        d->self->finish(d->id, "");
+    }
+    return G_SOURCE_REMOVE;
 }
 
-bool ClipboardManager::ping() {
-    std::string response = sendCommand("ping");
-    return response.find("\"ok\"") != std::string::npos;
+void ClipboardManager::failLater(uint64_t id) {
+    auto it = m_pending.find(id);
+    if (it == m_pending.end()) return;
+    if (it->second.timeoutSource) g_source_remove(it->second.timeoutSource);
+    it->second.timeoutSource = g_idle_add_full(G_PRIORITY_DEFAULT_IDLE, onRequestExpired,
+        new RequestSourceData{this, id}, freeRequestSourceData);
+}
+
+uint64_t ClipboardManager::request(const std::string& cmd, const std::string& argsJson,
+                                   FrameCallback onFrame, ReplyCallback onReply) {
+    uint64_t id = m_nextId++;
+    std::string payload = "{\"id\":" + std::to_string(id) + ",\"cmd\":\"" + cmd +
+                          "\",\"args\":" + argsJson + "}";
+
+    Pending& p = m_pending[id];
+    p.frame = encodeFrame(payload);
+    p.idempotent = isIdempotent(cmd);
+    p.onFrame = std::move(onFrame);
+    p.onReply = std::move(onReply);
+
+    if (!ensureConnected()) {
+        failLater(id);
+        return id;
+    }
+
+    p.timeoutSource = g_timeout_add_seconds_full(G_PRIORITY_DEFAULT, REQUEST_TIMEOUT_S,
+        onRequestExpired, new RequestSourceData{this, id}, freeRequestSourceData);
+    queueWrite(p.frame);
+    return id;
+}
+
+void ClipboardManager::cancel(uint64_t id) {
+    auto it = m_pending.find(id);
+    if (it == m_pending.end()) return;
+    if (it->second.timeoutSource) g_source_remove(it->second.timeoutSource);
+    m_pending.erase(it);
 }
 
 // ============================================================================
-// JSON Parsing (minimal, for clipman-daemon responses only)
+// Change feed — "subscribe" answers with what we missed, then the daemon
+// pushes every change on this connection
 // ============================================================================
 
-static std::string extractJsonString(const std::string& json, const std::string& key) {
-    std::string needle = "\"" + key + "\":";
-    size_t pos = json.find(needle);
-    if (pos == std::string::npos) return "";
-    pos += needle.size();
-
-    // Skip whitespace
-    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t')) pos++;
-
-    if (pos >= json.size()) return "";
-
-    if (json[pos] == '"') {
-        // String value
-        pos++;
-        std::string result;
-        while (pos < json.size() && json[pos] != '"') {
-            if (json[pos] == '\\' && pos + 1 < json.size()) {
-                pos++;
-                if (json[pos] == '"') result += '"';
-                else if (json[pos] == '\\') result += '\\';
-                else if (json[pos] == 'n') result += '\n';
-                else if (json[pos] == 't') result += '\t';
-                else result += json[pos];
-            } else {
-                result += json[pos];
+void ClipboardManager::subscribe(FeedHandler handler, std::function<uint64_t()> since) {
+    m_feed = std::move(handler);
+    m_feedSince = std::move(since);
+    startFeed();
+}
+
+void ClipboardManager::startFeed() {
+    if (!m_feedSince || m_feedRequest || m_feedLive) return;
+
+    std::string args = "{\"since\":" + std::to_string(m_feedSince()) + "}";
+    auto snapshot = std::make_shared<EntryStore::Builder>();
+    m_feedBacklog.clear();
+    m_feedRequest = request("subscribe", args,
+        [snapshot](const std::string& frame) {
+            // A resync streams the snapshot in chunks, like a list reply;
+            // each goes into the store as it arrives
+            ReplyEnvelope env;
+            std::vector<ClipboardEntry> chunk;
+            if (parseReplyEnvelope(frame, env) && env.ok && env.resync &&
+                parseListReply(frame, chunk)) {
+                for (const auto& entry : chunk) snapshot->append(entry);
+            }
+        },
+        [this, snapshot](const std::string& reply) {
+            m_feedRequest = 0;
+
+            ReplyEnvelope env;
+            std::vector<HistoryChange> changes;
+            bool ok = parseReplyEnvelope(reply, env) && env.ok &&
+                      (env.resync || parseChangeList(reply, changes));
+            if (!ok) {
+                scheduleFeedRetry(FEED_RETRY_MS);
+                return;
             }
-            pos++;
-        }
-        return result;
-    }
 
-    if (json[pos] == 'n') return "";  // null
+            m_feedLive = true;
+            if (env.resync) {
+                if (m_feed.onSnapshot) m_feed.onSnapshot(snapshot->build(), env.generation);
+            } else if (m_feed.onChanges) {
+                m_feed.onChanges(changes, env.generation);
+            }
 
-    // Number or boolean - read until delimiter
-    std::string result;
-    while (pos < json.size() && json[pos] != ',' && json[pos] != '}' && json[pos] != ']') {
-        result += json[pos++];
-    }
-    return result;
+            auto backlog = std::move(m_feedBacklog);
+            m_feedBacklog.clear();
+            for (const auto& [generation, pushed] : backlog)
+                if (generation > env.generation && m_feed.onChanges)
+                    m_feed.onChanges(pushed, generation);
+        });
 }
 
-std::vector<ClipboardEntry> ClipboardManager::parseListResponse(const std::string& json) {
-    std::vector<ClipboardEntry> items;
+void ClipboardManager::scheduleFeedRetry(guint delayMs) {
+    if (!m_feedRetry) m_feedRetry = g_timeout_add(delayMs, onFeedRetry, this);
+}
+
+gboolean ClipboardManager::onFeedRetry(gpointer data) {
+    auto* self = static_cast<ClipboardManager*>(data);
+    self->m_feedRetry = 0;
+    self->startFeed();
+    return G_SOURCE_REMOVE;
+}
 
-    // Check status
-    if (json.find("\"ok\"") == std::string::npos) return items;
-
-    // Find data array
-    size_t dataPos = json.find("\"data\":");
-    if (dataPos == std::string::npos) return items;
-
-    size_t arrayStart = json.find('[', dataPos);
-    if (arrayStart == std::string::npos) return items;
-
-    // Split into objects by finding matching braces
-    int depth = 0;
-    size_t objStart = 0;
-    for (size_t i = arrayStart; i < json.size(); i++) {
-        if (json[i] == '{') {
-            if (depth == 0) objStart = i;
-            depth++;
-        } else if (json[i] == '}') {
-            depth--;
-            if (depth == 0) {
-                std::string obj = json.substr(objStart, i - objStart + 1);
-
-                ClipboardEntry entry;
-                entry.uuid = extractJsonString(obj, "uuid");
-                entry.type = extractJsonString(obj, "type");
-                if (entry.type.empty())
-                    entry.type = extractJsonString(obj, "content_type");
-                entry.preview = extractJsonString(obj, "preview");
-                entry.thumb = extractJsonString(obj, "thumb");
-                entry.createdAt = extractJsonString(obj, "created_at");
-
-                std::string fav = extractJsonString(obj, "favorite");
-                if (fav.empty()) fav = extractJsonString(obj, "is_favorite");
-                entry.favorite = (fav == "true" || fav == "1" || fav == "True");
-
-                if (!entry.uuid.empty()) {
-                    items.push_back(std::move(entry));
-                }
+// ============================================================================
+// Daemon Commands
+// ============================================================================
+
+static ClipboardManager::ReplyCallback resultOf(ClipboardManager::ResultCallback done) {
+    return [done = std::move(done)](const std::string& reply) {
+        if (done) done(isOk(reply));
+    };
+}
+
+uint64_t ClipboardManager::fetchItems(const std::string& filter, const std::string& search,
+                                      int limit, const std::string& after,
+                                      BatchCallback onBatch, ListCallback onDone) {
+    std::string args = "{\"filter\":\"" + escapeJsonString(filter) + "\"";
+    if (!search.empty())
+        args += ",\"search\":\"" + escapeJsonString(search) + "\"";
+    if (!after.empty())
+        args += ",\"after\":\"" + escapeJsonString(after) + "\"";
+    args += ",\"limit\":" + std::to_string(limit) + "}";
+
+    // Each streamed chunk is parsed and handed out as soon as it arrives
+    auto items = std::make_shared<std::vector<ClipboardEntry>>();
+    return request("list", args,
+        [this, items, onBatch = std::move(onBatch)](const std::string& frame) {
+            std::vector<ClipboardEntry> batch = parseListResponse(frame);
+            if (batch.empty()) return;
+            if (onBatch) onBatch(batch);
+            items->insert(items->end(), std::make_move_iterator(batch.begin()),
+                          std::make_move_iterator(batch.end()));
+        },
+        [items, onDone = std::move(onDone)](const std::string& reply) {
+            // Every chunk carries the envelope; the last one stands for all
+            ReplyEnvelope env;
+            ListPage page;
+            if (parseReplyEnvelope(reply, env) && env.ok) {
+                page.generation = env.generation;
+                page.nextCursor = std::move(env.nextCursor);
             }
-        } else if (json[i] == ']' && depth == 0) {
-            break;
-        }
+            page.items = std::move(*items);
+            if (onDone) onDone(std::move(page));
+        });
+}
+
+uint64_t ClipboardManager::paste(const std::string& uuid, ResultCallback done) {
+    std::string args = "{\"uuid\":\"" + escapeJsonString(uuid) + "\"}";
+    return request("paste", args, {}, resultOf(std::move(done)));
+}
+
+uint64_t ClipboardManager::toggleFavorite(const std::string& uuid, ResultCallback done) {
+    std::string args = "{\"uuid\":\"" + escapeJsonString(uuid) + "\"}";
+    return request("favorite", args, {}, resultOf(std::move(done)));
+}
+
+uint64_t ClipboardManager::deleteItem(const std::string& uuid, ResultCallback done) {
+    std::string args = "{\"uuid\":\"" + escapeJsonString(uuid) + "\"}";
+    return request("delete", args, {}, resultOf(std::move(done)));
+}
+
+uint64_t ClipboardManager::clearAll(ResultCallback done) {
+    return request("clear", "{}", {}, resultOf(std::move(done)));
+}
+
+uint64_t ClipboardManager::ping(ResultCallback done) {
+    return request("ping", "{}", {}, resultOf(std::move(done)));
+}
+
+static std::string uuidArray(const std::vector<std::string>& uuids) {
+    std::string out = "[";
+    for (size_t i = 0; i < uuids.size(); i++) {
+        if (i) out += ',';
+        out += '"' + escapeJsonString(uuids[i]) + '"';
     }
+    return out + "]";
+}
 
+static ClipboardManager::ReplyCallback changesOf(ClipboardManager::ChangesCallback done) {
+    return [done = std::move(done)](const std::string& reply) {
+        if (!done) return;
+        ReplyEnvelope env;
+        std::vector<HistoryChange> changes;
+        bool ok = parseChangeList(reply, changes, &env) && env.ok;
+        done(ok, changes, env.generation);
+    };
+}
+
+uint64_t ClipboardManager::paste(const std::vector<std::string>& uuids, ResultCallback done) {
+    return request("paste", "{\"uuids\":" + uuidArray(uuids) + "}", {},
+                   resultOf(std::move(done)));
+}
+
+uint64_t ClipboardManager::setFavorite(const std::vector<std::string>& uuids, bool favorite,
+                                       ChangesCallback done) {
+    std::string args = "{\"uuids\":" + uuidArray(uuids) +
+                       ",\"favorite\":" + (favorite ? "true" : "false") + "}";
+    return request("favorite_many", args, {}, changesOf(std::move(done)));
+}
+
+uint64_t ClipboardManager::deleteItems(const std::vector<std::string>& uuids,
+                                       ChangesCallback done) {
+    return request("delete_many", "{\"uuids\":" + uuidArray(uuids) + "}", {},
+                   changesOf(std::move(done)));
+}
+
+// ============================================================================
+// Reply decoding (single pass, see JsonParser.hpp)
+// ============================================================================
+
+static bool isOk(const std::string& response) {
+    ReplyEnvelope env;
+    return parseReplyEnvelope(response, env) && env.ok;
+}
+
+std::vector<ClipboardEntry> ClipboardManager::parseListResponse(std::string_view json) {
+    std::vector<ClipboardEntry> items;
+    ReplyEnvelope env;
+    if (!parseListReply(json, items, &env) || !env.ok) return {};
     return items;
 }
 
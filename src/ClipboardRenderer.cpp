@@ -3,6 +3,7 @@
 
 #include "hyprclipx/ClipboardRenderer.hpp"
 #include "hyprclipx/ClipboardManager.hpp"
+#include "hyprclipx/EntryListModel.hpp"
 #include <cstdlib>
 #include <cstdio>
 #include <cstring>
@@ -10,29 +11,22 @@
 #include <chrono>
 #include <algorithm>
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <sstream>
+#include <string_view>
 #include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 namespace hyprclipx {
 
-// ── Terminal identifiers (1:1 from AGS) ─────────────────────────────────────
-static const std::vector<std::string> TERMINAL_IDENTIFIERS = {
-    "kitty", "alacritty", "foot", "wezterm", "konsole",
-    "gnome-terminal", "xterm", "urxvt", "terminator", "tilix",
-    "st", "rxvt", "sakura", "terminology", "guake", "tilda",
-    "hyper", "tabby", "contour", "cool-retro-term", "claude"
-};
-
 // ── Filter definitions (SSOT) ───────────────────────────────────────────────
 static const std::string FILTER_NAMES[] = {"all", "favorites", "text", "image"};
 static const char* FILTER_ICONS[] = {"\xe2\x8a\x9b", "\xe2\x98\x86", "\xf0\x9d\x90\x93", "\xf0\x9f\x96\xbc"};
 
-// ── Browser identifiers (SSOT) ─────────────────────────────────────────────
-static const std::vector<std::string> BROWSER_IDENTIFIERS = {
-    "firefox", "chrome", "chromium", "brave", "vivaldi",
-    "opera", "zen", "floorp", "librewolf", "edge"
-};
-
 // ── CSS — compact horizontal layout, HyprZones dark theme ───────────────────
 static const char* CLIPBOARD_CSS = R"CSS(
 .ClipboardManager { background: transparent; }
@@ -114,7 +108,15 @@ static const char* CLIPBOARD_CSS = R"CSS(
 
 /* ── Item list ── */
 .cm-scroll { min-height: 120px; }
-.cm-list { padding: 2px 4px; }
+.cm-list {
+  padding: 2px 4px;
+  background: transparent;
+}
+.cm-list > row {
+  padding: 0;
+  margin-bottom: 1px;
+  background: transparent;
+}
 
 .cm-item {
   padding: 3px 8px;
@@ -133,6 +135,10 @@ static const char* CLIPBOARD_CSS = R"CSS(
 .cm-item.selected:hover {
   background: rgba(58, 106, 58, 0.25);
 }
+.cm-item.marked {
+  background: rgba(42, 90, 42, 0.12);
+  border-color: #2a4a2a;
+}
 
 .cm-triangle {
   font-size: 9px;
@@ -152,24 +158,12 @@ static const char* CLIPBOARD_CSS = R"CSS(
   color: #9aaa9a;
 }
 
-.cm-fav-column {
-  border-left: 1px solid #1a1a1a;
-  min-width: 26px;
-  padding: 2px 0;
-}
-
 .cm-fav-indicator {
   font-size: 10px;
   color: #2a3a3a;
   min-width: 26px;
   padding: 3px 0;
-  border: 1px solid transparent;
-  border-radius: 0;
-  background: transparent;
-}
-.cm-fav-indicator:hover {
-  background: transparent;
-  border-color: transparent;
+  border-left: 1px solid #1a1a1a;
 }
 .cm-fav-indicator.starred {
   color: #f9e2af;
@@ -181,6 +175,12 @@ static const char* CLIPBOARD_CSS = R"CSS(
   margin-right: 4px;
 }
 
+.cm-thumb {
+  background: #141c1c;
+  border-radius: 2px;
+  margin-right: 4px;
+}
+
 /* ── Hint bar ── */
 .cm-hints {
   background: #0a0a0a;
@@ -208,10 +208,15 @@ static const char* CLIPBOARD_CSS = R"CSS(
 // ── Ctor / Dtor ─────────────────────────────────────────────────────────────
 
 ClipboardRenderer::ClipboardRenderer(Config& config, ClipboardManager& manager)
-    : m_config(config), m_manager(manager) {}
+    : m_config(config), m_manager(manager), m_classifier(config.pasteRules) {}
 
 ClipboardRenderer::~ClipboardRenderer() {
+    *m_alive = false;  // paste steps still in flight stop short of this
+    if (m_searchDebounce) g_source_remove(m_searchDebounce);
     if (m_window) { gtk_window_destroy(GTK_WINDOW(m_window)); m_window = nullptr; }
+    // After the window: hiding it on the way out schedules one
+    if (m_prewarmIdle) g_source_remove(m_prewarmIdle);
+    if (m_listModel) g_object_unref(m_listModel);
 }
 
 // ── Helpers ─────────────────────────────────────────────────────────────────
@@ -228,9 +233,122 @@ std::string ClipboardRenderer::exec(const std::string& cmd) {
     return result;
 }
 
-static std::string toLower(std::string s) {
-    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
-    return s;
+// Connects to one of Hyprland's sockets (".socket.sock": commands,
+// ".socket2.sock": events); -1 if Hyprland isn't reachable
+static int connectHyprland(const char* name) {
+    const char* runtime = std::getenv("XDG_RUNTIME_DIR");
+    const char* instance = std::getenv("HYPRLAND_INSTANCE_SIGNATURE");
+    if (!runtime || !instance) return -1;
+    std::string path = std::string(runtime) + "/hypr/" + instance + "/" + name;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) return -1;
+    struct sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == -1) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// One request on Hyprland's command socket, the way hyprctl sends it
+// ("j/activewindow", "/dispatch …"); the reply, or "" if Hyprland isn't
+// reachable. Saves starting hyprctl for every paste.
+static std::string hyprlandRequest(const std::string& request) {
+    int fd = connectHyprland(".socket.sock");
+    if (fd == -1) return "";
+    timeval tv{1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    std::string reply;
+    if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(request.size())) {
+        // Hyprland answers, then closes
+        std::array<char, 4096> buf;
+        ssize_t n;
+        while ((n = recv(fd, buf.data(), buf.size(), 0)) > 0)
+            reply.append(buf.data(), static_cast<size_t>(n));
+    }
+    close(fd);
+    return reply;
+}
+
+// Reads Hyprland events from `fd` until the window at `address` ("0x…")
+// is reported active ("activewindowv2>>…", address without 0x) or
+// `timeoutMs` has passed. False on timeout.
+static bool waitForActiveWindow(int fd, const std::string& address, int timeoutMs) {
+    std::string want = "activewindowv2>>" +
+        (address.starts_with("0x") ? address.substr(2) : address);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    std::string buf;
+    while (true) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        pollfd pfd{fd, POLLIN, 0};
+        if (left <= 0 || poll(&pfd, 1, static_cast<int>(left)) <= 0) return false;
+
+        char chunk[4096];
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        buf.append(chunk, static_cast<size_t>(n));
+        size_t start = 0, nl;
+        while ((nl = buf.find('\n', start)) != std::string::npos) {
+            if (std::string_view(buf).substr(start, nl - start) == want) return true;
+            start = nl + 1;
+        }
+        buf.erase(0, start);
+    }
+}
+
+// Hyprland window addresses, with or without their "0x"
+static bool sameWindow(std::string_view a, std::string_view b) {
+    if (a.starts_with("0x")) a.remove_prefix(2);
+    if (b.starts_with("0x")) b.remove_prefix(2);
+    return !a.empty() && a == b;
+}
+
+// Queue fn on the GTK main thread (the daemon connection lives there)
+static void runOnMainThread(std::function<void()> fn) {
+    g_main_context_invoke_full(nullptr, G_PRIORITY_DEFAULT,
+        +[](gpointer d) -> gboolean {
+            (*static_cast<std::function<void()>*>(d))();
+            return G_SOURCE_REMOVE;
+        },
+        new std::function<void()>(std::move(fn)),
+        +[](gpointer d) { delete static_cast<std::function<void()>*>(d); });
+}
+
+// Pango markup for `text` with the characters starting at `positions`
+// (ascending byte offsets) in bold, adjacent ones sharing one span
+static std::string highlightMarkup(const std::string& text, const std::vector<uint32_t>& positions) {
+    std::string markup;
+    auto append = [&](size_t from, size_t to) {
+        char* escaped = g_markup_escape_text(text.data() + from, static_cast<gssize>(to - from));
+        markup += escaped;
+        g_free(escaped);
+    };
+
+    size_t done = 0;
+    for (size_t i = 0; i < positions.size();) {
+        size_t start = positions[i];
+        if (start < done || start >= text.size()) break;
+        size_t end = start;
+        // Extend over this and any directly following matched characters
+        while (i < positions.size() && positions[i] == end && end < text.size()) {
+            const char* next = g_utf8_next_char(text.data() + end);
+            end = static_cast<size_t>(next - text.data());
+            i++;
+        }
+        append(done, start);
+        markup += "<b>";
+        append(start, std::min(end, text.size()));
+        markup += "</b>";
+        done = std::min(end, text.size());
+    }
+    append(done, text.size());
+    return markup;
 }
 
 // ── Initialize ──────────────────────────────────────────────────────────────
@@ -260,6 +378,8 @@ void ClipboardRenderer::initialize() {
     gtk_widget_add_css_class(m_window, "ClipboardManager");
 
     buildUI();
+    subscribeHistory();
+    schedulePrewarm();
 
     g_signal_connect(m_window, "close-request",
         G_CALLBACK(+[](GtkWindow*, gpointer d) -> gboolean {
@@ -271,25 +391,97 @@ void ClipboardRenderer::initialize() {
 
     g_signal_connect(m_window, "map",
         G_CALLBACK(+[](GtkWidget*, gpointer d) {
-            static_cast<ClipboardRenderer*>(d)->repositionWindow();
+            auto* s = static_cast<ClipboardRenderer*>(d);
+            s->repositionWindow();
+
+            // Hotkey → first frame latency, taken when the first frame starts
+            if (!s->m_showRequestTime) return;
+            gtk_widget_add_tick_callback(s->m_window,
+                +[](GtkWidget*, GdkFrameClock*, gpointer d) -> gboolean {
+                    auto* s = static_cast<ClipboardRenderer*>(d);
+                    if (s->m_showRequestTime)
+                        s->m_showLatency.record(g_get_monotonic_time() - s->m_showRequestTime);
+                    s->m_showRequestTime = 0;
+                    return G_SOURCE_REMOVE;
+                }, s, nullptr);
         }), this);
 
+    // The rows were prepared while hidden: only refresh what went stale
     g_signal_connect(m_window, "show",
         G_CALLBACK(+[](GtkWidget*, gpointer d) {
             auto* s = static_cast<ClipboardRenderer*>(d);
-            std::ifstream f(s->m_config.prevWindowFile);
-            if (f.is_open()) std::getline(f, s->m_previousWindowAddress);
-            s->m_selectedIndex = 0;
-            s->m_search.clear();
-            if (s->m_searchEntry)
-                gtk_editable_set_text(GTK_EDITABLE(s->m_searchEntry), "");
-            if (s->m_scrolled) {
-                auto* vadj = gtk_scrolled_window_get_vadjustment(
-                    GTK_SCROLLED_WINDOW(s->m_scrolled));
-                if (vadj) gtk_adjustment_set_value(vadj, 0);
+            s->m_shows++;
+            if (s->m_prewarmIdle) {
+                g_source_remove(s->m_prewarmIdle);
+                s->m_prewarmIdle = 0;
+                s->updateList();
+            } else if (s->viewIsCurrent()) {
+                s->m_showsPrepared++;
+            } else if (!s->m_listRequest) {
+                s->updateList();
             }
-            s->updateList();
         }), this);
+
+    // Every way of closing (Escape, paste, hide command) ends here
+    g_signal_connect(m_window, "hide",
+        G_CALLBACK(+[](GtkWidget*, gpointer d) {
+            auto* s = static_cast<ClipboardRenderer*>(d);
+            s->m_visible = false;
+            s->resetView();
+            s->schedulePrewarm();
+        }), this);
+}
+
+// Back to the first page of the current filter, unsearched, cursor on top
+void ClipboardRenderer::resetView() {
+    m_selectedIndex = m_anchorIndex = 0;
+    m_shown.limit = 0;  // start over at the first page
+    m_search.clear();
+    if (m_searchEntry)
+        gtk_editable_set_text(GTK_EDITABLE(m_searchEntry), "");
+    if (m_scrolled) {
+        auto* vadj = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(m_scrolled));
+        if (vadj) gtk_adjustment_set_value(vadj, 0);
+    }
+}
+
+// While hidden, bring the rows up to date once the main loop is idle, so the
+// next show finds them current instead of querying on the hotkey's clock
+void ClipboardRenderer::schedulePrewarm() {
+    if (m_visible || m_prewarmIdle) return;
+    m_prewarmIdle = g_idle_add_full(G_PRIORITY_LOW, +[](gpointer d) -> gboolean {
+        auto* s = static_cast<ClipboardRenderer*>(d);
+        s->m_prewarmIdle = 0;
+        if (!s->m_visible) s->updateList();
+        return G_SOURCE_REMOVE;
+    }, this, nullptr);
+}
+
+// The rows on screen answer the current query at the current generation
+bool ClipboardRenderer::viewIsCurrent() const {
+    uint64_t generation = currentGeneration();
+    return m_shown.filter == m_filter && m_shown.search == m_search && m_shown.limit > 0 &&
+           generation != 0 && m_shown.generation == generation;
+}
+
+// Mirror the daemon's history for the whole process lifetime; an open
+// window follows changes as they are pushed, a hidden one re-prepares
+void ClipboardRenderer::subscribeHistory() {
+    ClipboardManager::FeedHandler feed;
+    feed.onSnapshot = [this](std::shared_ptr<const EntryStore> store, uint64_t generation) {
+        m_history.reset(std::move(store), generation);
+        if (m_visible) updateList();
+        else schedulePrewarm();
+    };
+    feed.onChanges = [this](const std::vector<HistoryChange>& changes, uint64_t generation) {
+        uint64_t before = m_history.generation();
+        m_history.apply(changes, generation);
+        if (m_history.generation() == before) return;
+        if (m_visible) updateList();
+        else schedulePrewarm();
+    };
+    feed.onLost = [this]() { m_history.invalidate(); };
+    m_manager.subscribe(std::move(feed), [this]() { return m_history.generation(); });
 }
 
 // ── UI Assembly ─────────────────────────────────────────────────────────────
@@ -333,21 +525,42 @@ void ClipboardRenderer::buildUI() {
     gtk_widget_set_hexpand(m_scrolled, TRUE);
     gtk_widget_add_css_class(m_scrolled, "cm-scroll");
 
-    // Scroll content: [item-list | fav-column]
-    GtkWidget* scrollContent = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 0);
-
-    m_listBox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 1);
-    gtk_widget_add_css_class(m_listBox, "cm-list");
-    gtk_widget_set_hexpand(m_listBox, TRUE);
-    gtk_box_append(GTK_BOX(scrollContent), m_listBox);
-
-    m_favBox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 1);
-    gtk_widget_add_css_class(m_favBox, "cm-fav-column");
-    gtk_widget_set_vexpand(m_favBox, TRUE);
-    gtk_box_append(GTK_BOX(scrollContent), m_favBox);
+    // Virtualized list: rows exist only for what is in view (plus a little
+    // overscan) and are recycled as it scrolls; m_items stays the data
+    m_listModel = entryListModelNew(&m_items);
+    GtkListItemFactory* factory = gtk_signal_list_item_factory_new();
+    g_signal_connect(factory, "setup", G_CALLBACK(onRowSetup), this);
+    g_signal_connect(factory, "bind", G_CALLBACK(onRowBind), this);
+    g_signal_connect(factory, "unbind", G_CALLBACK(onRowUnbind), this);
+    GtkSelectionModel* selection = GTK_SELECTION_MODEL(
+        gtk_no_selection_new(G_LIST_MODEL(g_object_ref(m_listModel))));
+    m_listView = gtk_list_view_new(selection, factory);
+    gtk_widget_add_css_class(m_listView, "cm-list");
+    gtk_widget_set_hexpand(m_listView, TRUE);
+    gtk_widget_set_can_focus(m_listView, FALSE);
+    gtk_list_view_set_single_click_activate(GTK_LIST_VIEW(m_listView), TRUE);
+
+    // Click → paste
+    g_signal_connect(m_listView, "activate",
+        G_CALLBACK(+[](GtkListView*, guint position, gpointer d) {
+            auto* s = static_cast<ClipboardRenderer*>(d);
+            if (position >= s->m_items.size()) return;
+            const ClipboardEntry& item = s->m_items[position];
+            s->pasteItems({item.uuid}, item.type);
+        }), this);
 
-    gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(m_scrolled), scrollContent);
+    gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(m_scrolled), m_listView);
     gtk_box_append(GTK_BOX(bodyRow), m_scrolled);
+
+    // Infinite scroll: fetch the next page before the end comes into view
+    g_signal_connect(gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(m_scrolled)),
+        "value-changed", G_CALLBACK(+[](GtkAdjustment* adj, gpointer d) {
+            auto* s = static_cast<ClipboardRenderer*>(d);
+            double upper = gtk_adjustment_get_upper(adj);
+            double value = gtk_adjustment_get_value(adj);
+            double page = gtk_adjustment_get_page_size(adj);
+            if (upper - (value + page) < PREFETCH_ROWS * ITEM_HEIGHT) s->loadMore();
+        }), this);
     gtk_box_append(GTK_BOX(root), bodyRow);
 
     // Hint bar (full width)
@@ -407,7 +620,7 @@ GtkWidget* ClipboardRenderer::createSidebarBody() {
                 auto* fd = static_cast<FilterData*>(d);
                 fd->self->m_filterIndex = fd->idx;
                 fd->self->m_filter = FILTER_NAMES[fd->idx];
-                fd->self->m_selectedIndex = 0;
+                fd->self->m_selectedIndex = fd->self->m_anchorIndex = 0;
                 fd->self->updateFilterIcons();
                 fd->self->updateList();
             }), fd);
@@ -433,8 +646,7 @@ GtkWidget* ClipboardRenderer::createSidebarBody() {
     g_signal_connect(clearBtn, "clicked",
         G_CALLBACK(+[](GtkButton*, gpointer d) {
             auto* s = static_cast<ClipboardRenderer*>(d);
-            s->m_manager.clearAll();
-            s->updateList();
+            s->m_manager.clearAll([s](bool) { s->updateList(); });
         }), this);
     gtk_box_append(GTK_BOX(bar), clearBtn);
 
@@ -465,9 +677,11 @@ GtkWidget* ClipboardRenderer::createSearchBar() {
         G_CALLBACK(+[](GtkEditable*, gpointer d) {
             auto* s = static_cast<ClipboardRenderer*>(d);
             const char* t = gtk_editable_get_text(GTK_EDITABLE(s->m_searchEntry));
-            s->m_search = t ? t : "";
-            s->m_selectedIndex = 0;
-            s->updateList();
+            std::string text = t ? t : "";
+            if (text == s->m_search) return;  // e.g. reset on show
+            s->m_search = std::move(text);
+            s->m_selectedIndex = s->m_anchorIndex = 0;
+            s->scheduleSearch();
         }), this);
 
     gtk_box_append(GTK_BOX(box), m_searchEntry);
@@ -498,123 +712,417 @@ GtkWidget* ClipboardRenderer::createHintBar() {
 
 // ── List management ─────────────────────────────────────────────────────────
 
-void ClipboardRenderer::removeAllChildren(GtkWidget* box) {
-    GtkWidget* child = gtk_widget_get_first_child(box);
-    while (child) {
-        GtkWidget* next = gtk_widget_get_next_sibling(child);
-        gtk_box_remove(GTK_BOX(box), child);
-        child = next;
+// m_items is what the list model shows: every change goes through here so
+// the list view hears about it. A refresh is reconciled by uuid, so rows
+// that didn't change keep their widgets (and the list its scroll position).
+void ClipboardRenderer::setRows(std::vector<ClipboardEntry> items) {
+    if (m_listModel) entryListModelReconcile(m_listModel, m_items, std::move(items));
+    else m_items = std::move(items);
+}
+
+void ClipboardRenderer::appendRows(const std::vector<ClipboardEntry>& rows) {
+    auto position = static_cast<guint>(m_items.size());
+    m_items.insert(m_items.end(), rows.begin(), rows.end());
+    if (m_listModel)
+        entryListModelChanged(m_listModel, position, 0, static_cast<guint>(rows.size()));
+}
+
+// Type-ahead: coalesce keystrokes arriving within SEARCH_DEBOUNCE_MS, but
+// never hold results back longer than SEARCH_MAX_DELAY_MS while typing on.
+// Ranked locally, a keystroke costs well under a frame: no coalescing.
+void ClipboardRenderer::scheduleSearch() {
+    gint64 now = g_get_monotonic_time();
+    if (!m_searchKeyTime) m_searchKeyTime = now;
+
+    if (viewsLocally()) {
+        updateList();
+        return;
+    }
+    if (auto narrowed = narrowedRows()) {
+        updateList(std::move(narrowed));
+        return;
     }
+
+    // Whatever is in flight answers a query nobody wants any more
+    if (m_listRequest) m_manager.cancel(m_listRequest);
+    m_listRequest = 0;
+
+    if (m_searchDebounce) {
+        if (now - m_searchKeyTime >= SEARCH_MAX_DELAY_MS * 1000) return;
+        g_source_remove(m_searchDebounce);
+    }
+    m_searchDebounce = g_timeout_add(SEARCH_DEBOUNCE_MS, +[](gpointer d) -> gboolean {
+        auto* s = static_cast<ClipboardRenderer*>(d);
+        s->m_searchDebounce = 0;
+        s->updateList();
+        return G_SOURCE_REMOVE;
+    }, this);
 }
 
-void ClipboardRenderer::updateList() {
-    m_items = m_manager.fetchItems(m_filter, m_search, m_config.maxItems);
-    if (!m_listBox) return;
-    removeAllChildren(m_listBox);
-    if (m_favBox) removeAllChildren(m_favBox);
+static char asciiLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
 
-    for (size_t i = 0; i < m_items.size(); i++) {
-        const auto& item = m_items[i];
+// Case-insensitive (ASCII) substring, as the daemon's LIKE matches
+static bool containsFolded(std::string_view haystack, std::string_view needle) {
+    auto it = std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(),
+        [](char a, char b) { return asciiLower(a) == asciiLower(b); });
+    return it != haystack.end();
+}
 
-        // Item button (selection highlight only here)
-        GtkWidget* btn = gtk_button_new();
-        gtk_widget_set_can_focus(btn, FALSE);
-        gtk_widget_add_css_class(btn, "cm-item");
-        gtk_widget_add_css_class(btn, item.type.c_str());
-        if (static_cast<int>(i) == m_selectedIndex)
-            gtk_widget_add_css_class(btn, "selected");
-
-        GtkWidget* hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 4);
-
-        // Selection triangle
-        GtkWidget* triangle = gtk_label_new(
-            static_cast<int>(i) == m_selectedIndex ? "\xe2\x96\xb8" : " ");
-        gtk_widget_add_css_class(triangle, "cm-triangle");
-        gtk_box_append(GTK_BOX(hbox), triangle);
-
-        // Image indicator
-        if (item.type == "image") {
-            GtkWidget* imgIcon = gtk_label_new("\xe2\x96\xa0");
-            gtk_widget_add_css_class(imgIcon, "cm-img-indicator");
-            gtk_box_append(GTK_BOX(hbox), imgIcon);
-        }
+// The search extends the one on screen, whose result was complete and is
+// still current: every new match is among the rows shown, so they can be
+// narrowed without asking the daemon. A preview match is a match (previews
+// are the start of the text, whitespace folded to spaces — hence no
+// whitespace in the query); no preview match only rules a row out when the
+// preview is all of its text. One undecidable row, and the daemon's index
+// has to answer after all.
+std::optional<std::vector<ClipboardEntry>> ClipboardRenderer::narrowedRows() const {
+    if (!m_shown.complete || m_shown.generation == 0 ||
+        m_shown.generation != currentGeneration() || m_shown.filter != m_filter ||
+        m_search.size() <= m_shown.search.size() || !containsFolded(m_search, m_shown.search))
+        return std::nullopt;
+    // Beyond ASCII the index's case folding differs from LIKE's
+    for (char c : m_search)
+        if (static_cast<unsigned char>(c) <= ' ' || static_cast<unsigned char>(c) >= 0x7f)
+            return std::nullopt;
+
+    std::vector<ClipboardEntry> narrowed;
+    for (const auto& e : m_items) {
+        if (containsFolded(e.preview, m_search)) narrowed.push_back(e);
+        else if (!e.fullPreview) return std::nullopt;
+    }
+    return narrowed;
+}
 
-        // Preview text
-        GtkWidget* preview = gtk_label_new(
-            item.preview.empty() ? (item.type == "image" ? item.thumb.c_str() : "[Empty]")
-                                 : item.preview.c_str());
-        gtk_widget_set_hexpand(preview, TRUE);
-        gtk_label_set_xalign(GTK_LABEL(preview), 0);
-        gtk_label_set_max_width_chars(GTK_LABEL(preview), 60);
-        gtk_label_set_ellipsize(GTK_LABEL(preview), PANGO_ELLIPSIZE_END);
-        gtk_widget_add_css_class(preview, "cm-preview");
-        gtk_box_append(GTK_BOX(hbox), preview);
-
-        gtk_button_set_child(GTK_BUTTON(btn), hbox);
-
-        // Click → paste
-        struct ClickData { ClipboardRenderer* self; std::string uuid; std::string type; };
-        auto* cd = new ClickData{this, item.uuid, item.type};
-        g_signal_connect(btn, "clicked",
-            G_CALLBACK(+[](GtkButton*, gpointer d) {
-                auto* cd = static_cast<ClickData*>(d);
-                cd->self->pasteItem(cd->uuid, cd->type);
-            }), cd);
-
-        gtk_box_append(GTK_BOX(m_listBox), btn);
-
-        // Fav star (separate column, same widget type as cm-item = same height)
-        GtkWidget* star = gtk_button_new_with_label(
-            item.favorite ? "\xe2\x98\x85" : "\xe2\x98\x86");
-        gtk_widget_set_can_focus(star, FALSE);
-        gtk_widget_add_css_class(star, "cm-fav-indicator");
-        if (item.favorite) gtk_widget_add_css_class(star, "starred");
-        gtk_box_append(GTK_BOX(m_favBox), star);
+// The view can be derived from the live mirror; it only holds previews, so
+// full-text search (search_mode = "full") needs the daemon's index
+bool ClipboardRenderer::viewsLocally() const {
+    return m_history.synced() && (m_search.empty() || m_config.searchMode != "full");
+}
+
+// Generation the current history view corresponds to (0 = unknown)
+uint64_t ClipboardRenderer::currentGeneration() const {
+    return m_history.synced() ? m_history.generation() : m_manager.generation();
+}
+
+// `narrowed` hands over rows a caller already narrowed for the current search
+void ClipboardRenderer::updateList(std::optional<std::vector<ClipboardEntry>> narrowed) {
+    // This render covers any keystrokes still waiting to be coalesced
+    if (m_searchDebounce) g_source_remove(m_searchDebounce);
+    m_searchDebounce = 0;
+
+    // Supersede list requests still in flight; only the newest one renders
+    if (m_listRequest) m_manager.cancel(m_listRequest);
+    if (m_pageRequest) m_manager.cancel(m_pageRequest);
+    m_listRequest = m_pageRequest = 0;
+
+    int limit = m_config.maxItems;  // page size
+    uint64_t generation = currentGeneration();
+    bool sameQuery = m_shown.filter == m_filter && m_shown.search == m_search;
+
+    // Live mirror of the history: derive the view locally. A refresh of the
+    // same query keeps the pages already scrolled through.
+    if (viewsLocally()) {
+        int depth = sameQuery ? std::max(limit, m_shown.limit) : limit;
+        bool more = false;
+        auto items = m_history.query(m_filter, m_search, depth, 0, &more);
+        showItems(std::move(items), {m_filter, m_search, depth, generation, !more, {}});
+        return;
     }
 
-    // Update count
+    if (!narrowed) narrowed = narrowedRows();
+    if (narrowed) {
+        showItems(std::move(*narrowed), {m_filter, m_search, m_shown.limit, generation, true, {}});
+        return;
+    }
+
+    // History unchanged since this view was last fetched: no round trip
+    ListCache::Key key{m_filter, m_search, limit};
+    if (const auto* cached = m_listCache.lookup(key, generation)) {
+        showItems(cached->items, {m_filter, m_search, limit, generation,
+                                  cached->nextCursor.empty(), cached->nextCursor});
+        return;
+    }
+
+    // Old rows stay up until the first chunk of the new list arrives
+    auto replaced = std::make_shared<bool>(false);
+    auto replaceRows = [this, replaced]() {
+        if (*replaced) return;
+        *replaced = true;
+        setRows({});
+    };
+
+    // Rows are built chunk by chunk as the daemon streams the reply
+    m_listRequest = m_manager.fetchItems(m_filter, m_search, limit, {},
+        [this, replaceRows](const std::vector<ClipboardEntry>& batch) {
+            replaceRows();
+            appendRows(batch);
+        },
+        [this, replaceRows, key = std::move(key), limit](ListPage page) mutable {
+            replaceRows();
+            m_listRequest = 0;
+            // A failed fetch (generation 0) shows what arrived, with no next page
+            m_shown = {m_filter, m_search, limit, page.generation,
+                       page.nextCursor.empty(), page.nextCursor};
+            m_listCache.store(std::move(key), std::move(page));
+            finishList();
+        });
+}
+
+// Appends the next page of the query on screen: from the local model when
+// the rows came from it, else from the daemon at the shown page's cursor
+void ClipboardRenderer::loadMore() {
+    if (m_shown.complete || m_listRequest || m_pageRequest) return;
+    if (m_shown.filter != m_filter || m_shown.search != m_search) return;
+
+    int limit = m_config.maxItems;
+
+    if (m_shown.nextCursor.empty()) {
+        // Local rows are a prefix of the model's result only at its generation;
+        // otherwise an updateList() re-deriving them is on its way anyway
+        if (!m_history.synced() || m_shown.generation != m_history.generation()) return;
+        bool more = false;
+        auto page = m_history.query(m_filter, m_search, limit,
+                                    static_cast<int>(m_items.size()), &more);
+        appendRows(page);
+        m_shown.limit += limit;
+        m_shown.complete = !more;
+        finishList();
+        return;
+    }
+
+    // Rows go on screen once the page is complete: a request failing
+    // mid-stream would leave its first chunks behind, and the retry at the
+    // same cursor would show them a second time
+    m_pageRequest = m_manager.fetchItems(m_filter, m_search, limit, m_shown.nextCursor, {},
+        [this, limit](ListPage page) {
+            m_pageRequest = 0;
+            // Failed: keep the cursor, the next scroll retries
+            if (page.generation == 0) return;
+            appendRows(page.items);
+            // Keyset pages stay consistent across inserts, but the view as a
+            // whole no longer stands for a single generation
+            if (page.generation != m_shown.generation) m_shown.generation = 0;
+            m_shown.limit += limit;
+            m_shown.nextCursor = std::move(page.nextCursor);
+            m_shown.complete = m_shown.nextCursor.empty();
+            finishList();
+        });
+}
+
+void ClipboardRenderer::showItems(std::vector<ClipboardEntry> items, ShownView view) {
+    m_shown = std::move(view);
+    setRows(std::move(items));
+    finishList();
+}
+
+// Result of a batch command: patch what is on screen instead of refetching
+void ClipboardRenderer::applyLocalChanges(const std::vector<HistoryChange>& changes,
+                                          uint64_t generation) {
+    if (m_history.synced()) {
+        // The daemon sends this reply and the feed's pushes from different
+        // threads: a push for an earlier generation may still be on its way,
+        // and the model would drop it once it stood at `generation`. Apply
+        // only the very next generation; anything further is left to the
+        // feed, and a push that got here first makes this one stale.
+        if (generation == m_history.generation() + 1) {
+            m_history.apply(changes, generation);
+            updateList();
+        }
+        return;
+    }
+
+    std::vector<ClipboardEntry> items = m_items;
+    applyChanges(items, changes);
+    if (m_filter == "favorites")
+        std::erase_if(items, [](const ClipboardEntry& e) { return !e.favorite; });
+    // Still complete if it was: deletes and flag changes bring in nothing new
+    ShownView view = m_shown;
+    if (view.generation != 0) view.generation = generation;
+    showItems(std::move(items), std::move(view));
+}
+
+void ClipboardRenderer::finishList() {
+    // Keep the selection inside the (possibly shorter) list
+    int count = static_cast<int>(m_items.size());
+    if (m_selectedIndex >= count && count > 0) updateSelection(count - 1);
+    // Rows kept across the change may sit at new positions
+    for (GtkListItem* row : m_boundRows) styleRow(row);
+
     if (m_countLabel) {
         gtk_label_set_text(GTK_LABEL(m_countLabel),
                            std::to_string(m_items.size()).c_str());
     }
-}
 
-void ClipboardRenderer::updateSelection(int newIndex) {
-    if (newIndex == m_selectedIndex || !m_listBox) return;
-
-    int idx = 0;
-    GtkWidget* btn = gtk_widget_get_first_child(m_listBox);
-    while (btn) {
-        if (idx == m_selectedIndex || idx == newIndex) {
-            if (idx == m_selectedIndex) gtk_widget_remove_css_class(btn, "selected");
-            if (idx == newIndex)        gtk_widget_add_css_class(btn, "selected");
-            // Update triangle indicator
-            GtkWidget* hbox = gtk_button_get_child(GTK_BUTTON(btn));
-            if (hbox) {
-                GtkWidget* tri = gtk_widget_get_first_child(hbox);
-                if (tri && GTK_IS_LABEL(tri))
-                    gtk_label_set_text(GTK_LABEL(tri),
-                        idx == newIndex ? "\xe2\x96\xb8" : " ");
-            }
+    // Keystroke → frame latency, taken when the frame showing this result starts
+    if (m_searchKeyTime && m_listView) {
+        m_searchRenderKeyTime = m_searchKeyTime;
+        m_searchKeyTime = 0;
+        if (!m_searchTick) {
+            m_searchTick = gtk_widget_add_tick_callback(m_listView,
+                +[](GtkWidget*, GdkFrameClock*, gpointer d) -> gboolean {
+                    auto* s = static_cast<ClipboardRenderer*>(d);
+                    s->m_searchTick = 0;
+                    s->m_searchLatency.record(g_get_monotonic_time() - s->m_searchRenderKeyTime);
+                    return G_SOURCE_REMOVE;
+                }, this, nullptr);
         }
-        btn = gtk_widget_get_next_sibling(btn);
-        idx++;
     }
-    m_selectedIndex = newIndex;
-    scrollToIndex(newIndex);
+}
+
+// ── List rows (set up once per recycled widget, bound per entry) ──────────
+
+struct ClipboardRenderer::RowWidgets {
+    GtkWidget* item = nullptr;      // cm-item box: carries the selection state
+    GtkWidget* triangle = nullptr;
+    GtkWidget* thumb = nullptr;
+    GtkWidget* icon = nullptr;      // image without thumbnail
+    GtkWidget* preview = nullptr;
+    GtkWidget* star = nullptr;
+    std::string typeClass;          // CSS class of the bound entry's type
+};
+
+static constexpr const char* ROW_KEY = "hyprclipx-row";
+
+ClipboardRenderer::RowWidgets* ClipboardRenderer::rowWidgets(GtkListItem* row) {
+    return static_cast<RowWidgets*>(g_object_get_data(G_OBJECT(row), ROW_KEY));
+}
+
+void ClipboardRenderer::onRowSetup(GtkSignalListItemFactory*, GObject* object, gpointer) {
+    auto* w = new RowWidgets;
+    GtkWidget* row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 0);
+
+    w->item = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 4);
+    gtk_widget_add_css_class(w->item, "cm-item");
+    gtk_widget_set_hexpand(w->item, TRUE);
+
+    // Selection triangle (set by styleRow)
+    w->triangle = gtk_label_new(" ");
+    gtk_widget_add_css_class(w->triangle, "cm-triangle");
+    gtk_box_append(GTK_BOX(w->item), w->triangle);
+
+    // Image thumbnail: an empty frame until the cache has decoded it
+    w->thumb = gtk_picture_new();
+    gtk_picture_set_content_fit(GTK_PICTURE(w->thumb), GTK_CONTENT_FIT_CONTAIN);
+    gtk_picture_set_can_shrink(GTK_PICTURE(w->thumb), TRUE);
+    gtk_widget_set_size_request(w->thumb, THUMB_WIDTH, THUMB_HEIGHT);
+    gtk_widget_add_css_class(w->thumb, "cm-thumb");
+    gtk_box_append(GTK_BOX(w->item), w->thumb);
+
+    w->icon = gtk_label_new("\xe2\x96\xa0");
+    gtk_widget_add_css_class(w->icon, "cm-img-indicator");
+    gtk_box_append(GTK_BOX(w->item), w->icon);
+
+    w->preview = gtk_label_new("");
+    gtk_widget_set_hexpand(w->preview, TRUE);
+    gtk_label_set_xalign(GTK_LABEL(w->preview), 0);
+    gtk_label_set_max_width_chars(GTK_LABEL(w->preview), 60);
+    gtk_label_set_ellipsize(GTK_LABEL(w->preview), PANGO_ELLIPSIZE_END);
+    gtk_widget_add_css_class(w->preview, "cm-preview");
+    gtk_box_append(GTK_BOX(w->item), w->preview);
+    gtk_box_append(GTK_BOX(row), w->item);
+
+    // Fav star (own column at the right edge)
+    w->star = gtk_label_new("\xe2\x98\x86");
+    gtk_widget_add_css_class(w->star, "cm-fav-indicator");
+    gtk_box_append(GTK_BOX(row), w->star);
+
+    gtk_list_item_set_child(GTK_LIST_ITEM(object), row);
+    g_object_set_data_full(object, ROW_KEY, w, +[](gpointer d) { delete static_cast<RowWidgets*>(d); });
+}
+
+void ClipboardRenderer::onRowBind(GtkSignalListItemFactory*, GObject* object, gpointer d) {
+    auto* self = static_cast<ClipboardRenderer*>(d);
+    GtkListItem* row = GTK_LIST_ITEM(object);
+    RowWidgets* w = rowWidgets(row);
+    const ClipboardEntry& item = entryListItemEntry(gtk_list_item_get_item(row));
+
+    if (!w->typeClass.empty()) gtk_widget_remove_css_class(w->item, w->typeClass.c_str());
+    w->typeClass = item.type;
+    if (!w->typeClass.empty()) gtk_widget_add_css_class(w->item, w->typeClass.c_str());
+
+    bool image = item.type == "image";
+    gtk_widget_set_visible(w->thumb, image && !item.thumb.empty());
+    gtk_widget_set_visible(w->icon, image && item.thumb.empty());
+    if (image && !item.thumb.empty())
+        self->m_thumbnails.show(item.uuid, item.thumb, GTK_PICTURE(w->thumb));
+
+    // Preview text, search matches in bold
+    if (!item.highlight.empty() && !item.preview.empty()) {
+        gtk_label_set_markup(GTK_LABEL(w->preview), highlightMarkup(item.preview, item.highlight).c_str());
+    } else {
+        gtk_label_set_text(GTK_LABEL(w->preview),
+            item.preview.empty() ? (image ? item.thumb.c_str() : "[Empty]") : item.preview.c_str());
+    }
+
+    gtk_label_set_text(GTK_LABEL(w->star), item.favorite ? "\xe2\x98\x85" : "\xe2\x98\x86");
+    if (item.favorite) gtk_widget_add_css_class(w->star, "starred");
+    else               gtk_widget_remove_css_class(w->star, "starred");
+
+    self->m_boundRows.push_back(row);
+    self->styleRow(row);
+}
+
+void ClipboardRenderer::onRowUnbind(GtkSignalListItemFactory*, GObject* object, gpointer d) {
+    auto* self = static_cast<ClipboardRenderer*>(d);
+    GtkListItem* row = GTK_LIST_ITEM(object);
+    ThumbnailCache::clear(GTK_PICTURE(rowWidgets(row)->thumb));
+    std::erase(self->m_boundRows, row);
+}
+
+void ClipboardRenderer::updateSelection(int newIndex, bool extend) {
+    setSelection(extend ? m_anchorIndex : newIndex, newIndex);
+}
+
+void ClipboardRenderer::setSelection(int anchor, int cursor) {
+    if ((anchor == m_anchorIndex && cursor == m_selectedIndex) || !m_listView) return;
+
+    m_anchorIndex = anchor;
+    m_selectedIndex = cursor;
+
+    // Only rows that exist are in view; rows bound later are styled on bind
+    for (GtkListItem* row : m_boundRows) styleRow(row);
+    scrollToIndex(cursor);
+
+    // Moving towards the end of what is loaded pulls in the next page
+    if (cursor >= static_cast<int>(m_items.size()) - PREFETCH_ROWS) loadMore();
+}
+
+void ClipboardRenderer::styleRow(GtkListItem* row) {
+    RowWidgets* w = rowWidgets(row);
+    auto idx = static_cast<int>(gtk_list_item_get_position(row));
+    auto [lo, hi] = selectionRange();
+    bool cursor = idx == m_selectedIndex;
+    bool marked = hi > lo && idx >= lo && idx <= hi;
+
+    if (cursor) gtk_widget_add_css_class(w->item, "selected");
+    else        gtk_widget_remove_css_class(w->item, "selected");
+    if (marked) gtk_widget_add_css_class(w->item, "marked");
+    else        gtk_widget_remove_css_class(w->item, "marked");
+    // Restyling runs over every bound row: only a real change may queue a resize
+    const char* triangle = cursor ? "\xe2\x96\xb8" : " ";
+    int changed = g_strcmp0(gtk_label_get_text(GTK_LABEL(w->triangle)), triangle);
+    if (changed) gtk_label_set_text(GTK_LABEL(w->triangle), triangle);
+}
+
+std::pair<int, int> ClipboardRenderer::selectionRange() const {
+    return {std::min(m_anchorIndex, m_selectedIndex), std::max(m_anchorIndex, m_selectedIndex)};
+}
+
+// Selected items in list order (the cursor row alone without a range)
+std::vector<std::string> ClipboardRenderer::selectedUuids() const {
+    std::vector<std::string> uuids;
+    auto [lo, hi] = selectionRange();
+    for (int i = std::max(lo, 0); i <= hi && i < static_cast<int>(m_items.size()); i++)
+        uuids.push_back(m_items[i].uuid);
+    return uuids;
 }
 
 void ClipboardRenderer::scrollToIndex(int index) {
-    if (!m_scrolled) return;
-    GtkAdjustment* vadj = gtk_scrolled_window_get_vadjustment(
-        GTK_SCROLLED_WINDOW(m_scrolled));
-    if (!vadj) return;
-    double page = gtk_adjustment_get_page_size(vadj);
-    double top = index * ITEM_HEIGHT;
-    double bot = top + ITEM_HEIGHT;
-    double cur = gtk_adjustment_get_value(vadj);
-    if (bot > cur + page) gtk_adjustment_set_value(vadj, bot - page);
-    else if (top < cur)   gtk_adjustment_set_value(vadj, top);
+    if (!m_listView || index < 0 || index >= static_cast<int>(m_items.size())) return;
+    gtk_list_view_scroll_to(GTK_LIST_VIEW(m_listView), static_cast<guint>(index),
+                            GTK_LIST_SCROLL_NONE, nullptr);
 }
 
 void ClipboardRenderer::updateFilterIcons() {
@@ -643,6 +1151,7 @@ gboolean ClipboardRenderer::onKeyPress(GtkEventControllerKey*,
                                         GdkModifierType state, gpointer data) {
     auto* self = static_cast<ClipboardRenderer*>(data);
     int count = static_cast<int>(self->m_items.size());
+    bool extend = state & GDK_SHIFT_MASK;  // Shift+navigation grows the selection
 
     // Super+Alt+Arrow: move window offset
     if ((state & GDK_SUPER_MASK) && (state & GDK_ALT_MASK)) {
@@ -669,56 +1178,78 @@ gboolean ClipboardRenderer::onKeyPress(GtkEventControllerKey*,
         }
     }
 
-    // Ctrl+F: toggle favorite
+    // Ctrl+F: toggle favorite on the selection (a mixed selection becomes
+    // all favorites, an all-favorite one is cleared)
     if ((state & GDK_CONTROL_MASK) && (keyval == GDK_KEY_f || keyval == GDK_KEY_F)) {
-        if (!self->m_items.empty() && self->m_selectedIndex < count) {
-            self->m_manager.toggleFavorite(self->m_items[self->m_selectedIndex].uuid);
-            self->updateList();
+        std::vector<std::string> uuids = self->selectedUuids();
+        if (!uuids.empty()) {
+            auto [lo, hi] = self->selectionRange();
+            bool allFavorite = std::all_of(self->m_items.begin() + lo,
+                                           self->m_items.begin() + lo + uuids.size(),
+                                           [](const ClipboardEntry& e) { return e.favorite; });
+            self->m_manager.setFavorite(uuids, !allFavorite,
+                [self](bool ok, const std::vector<HistoryChange>& changes, uint64_t generation) {
+                    if (ok) self->applyLocalChanges(changes, generation);
+                });
         }
         return TRUE;
     }
 
+    // Ctrl+A: select everything in the current view
+    if ((state & GDK_CONTROL_MASK) && (keyval == GDK_KEY_a || keyval == GDK_KEY_A)) {
+        if (count > 0) self->setSelection(0, count - 1);
+        return TRUE;
+    }
+
     if (keyval == GDK_KEY_Escape) {
         gtk_widget_set_visible(self->m_window, FALSE);
         self->m_visible = false;
         return TRUE;
     }
     if (keyval == GDK_KEY_Down) {
-        self->updateSelection(std::min(self->m_selectedIndex + 1, count - 1));
+        self->updateSelection(std::min(self->m_selectedIndex + 1, count - 1), extend);
         return TRUE;
     }
     if (keyval == GDK_KEY_Up) {
-        self->updateSelection(std::max(self->m_selectedIndex - 1, 0));
+        self->updateSelection(std::max(self->m_selectedIndex - 1, 0), extend);
         return TRUE;
     }
     if (keyval == GDK_KEY_Return || keyval == GDK_KEY_KP_Enter) {
-        if (!self->m_items.empty() && self->m_selectedIndex < count)
-            self->pasteItem(self->m_items[self->m_selectedIndex].uuid,
-                            self->m_items[self->m_selectedIndex].type);
+        std::vector<std::string> uuids = self->selectedUuids();
+        if (uuids.size() == 1)
+            self->pasteItems(uuids, self->m_items[self->selectionRange().first].type);
+        else if (!uuids.empty())
+            self->pasteItems(uuids, "text");
         return TRUE;
     }
     if (keyval == GDK_KEY_Delete) {
-        if (!self->m_items.empty() && self->m_selectedIndex < count) {
-            self->m_manager.deleteItem(self->m_items[self->m_selectedIndex].uuid);
-            self->updateList();
-            if (self->m_selectedIndex >= static_cast<int>(self->m_items.size()))
-                self->m_selectedIndex = std::max(0, static_cast<int>(self->m_items.size()) - 1);
+        std::vector<std::string> uuids = self->selectedUuids();
+        if (!uuids.empty()) {
+            // One request for the whole selection; the cursor lands where it began
+            int first = self->selectionRange().first;
+            self->m_manager.deleteItems(uuids,
+                [self, first](bool ok, const std::vector<HistoryChange>& changes,
+                              uint64_t generation) {
+                    if (!ok) return;
+                    self->m_selectedIndex = self->m_anchorIndex = first;
+                    self->applyLocalChanges(changes, generation);
+                });
         }
         return TRUE;
     }
     if (keyval == GDK_KEY_Home) {
-        self->updateSelection(0);
+        self->updateSelection(0, extend);
         return TRUE;
     }
     if (keyval == GDK_KEY_End) {
-        self->updateSelection(std::max(0, count - 1));
+        self->updateSelection(std::max(0, count - 1), extend);
         return TRUE;
     }
     if (keyval == GDK_KEY_Tab) {
         int n = (self->m_filterIndex + 1) % 4;
         self->m_filterIndex = n;
         self->m_filter = FILTER_NAMES[n];
-        self->m_selectedIndex = 0;
+        self->m_selectedIndex = self->m_anchorIndex = 0;
         self->updateFilterIcons();
         self->updateList();
         return TRUE;
@@ -727,22 +1258,29 @@ gboolean ClipboardRenderer::onKeyPress(GtkEventControllerKey*,
         int n = (self->m_filterIndex + 3) % 4;
         self->m_filterIndex = n;
         self->m_filter = FILTER_NAMES[n];
-        self->m_selectedIndex = 0;
+        self->m_selectedIndex = self->m_anchorIndex = 0;
         self->updateFilterIcons();
         self->updateList();
         return TRUE;
     }
     if (keyval == GDK_KEY_BackSpace) {
+        // Drops the last character, not the last byte
         const char* t = gtk_editable_get_text(GTK_EDITABLE(self->m_searchEntry));
         std::string cur = t ? t : "";
-        if (!cur.empty()) { cur.pop_back(); gtk_editable_set_text(GTK_EDITABLE(self->m_searchEntry), cur.c_str()); }
+        if (!cur.empty()) {
+            const char* last = g_utf8_find_prev_char(cur.c_str(), cur.c_str() + cur.size());
+            cur.resize(last ? static_cast<size_t>(last - cur.c_str()) : 0);
+            gtk_editable_set_text(GTK_EDITABLE(self->m_searchEntry), cur.c_str());
+        }
         return TRUE;
     }
-    guint32 ch = gdk_keyval_to_unicode(keyval);
-    if (ch > 31 && ch < 127) {
+    // Any printable character (dead keys / compose already resolved by GDK)
+    gunichar ch = gdk_keyval_to_unicode(keyval);
+    if (ch && g_unichar_isprint(ch)) {
         const char* t = gtk_editable_get_text(GTK_EDITABLE(self->m_searchEntry));
         std::string cur = t ? t : "";
-        cur += static_cast<char>(ch);
+        char utf8[6];
+        cur.append(utf8, static_cast<size_t>(g_unichar_to_utf8(ch, utf8)));
         gtk_editable_set_text(GTK_EDITABLE(self->m_searchEntry), cur.c_str());
         return TRUE;
     }
@@ -751,47 +1289,83 @@ gboolean ClipboardRenderer::onKeyPress(GtkEventControllerKey*,
 
 // ── Smart paste (1:1 from AGS) ──────────────────────────────────────────────
 
-void ClipboardRenderer::pasteItem(const std::string& uuid, const std::string& itemType) {
+void ClipboardRenderer::pasteItems(std::vector<std::string> uuids, const std::string& itemType) {
+    // Listening before the window goes: hiding it may already hand focus back
+    int events = connectHyprland(".socket2.sock");
+
     gtk_widget_set_visible(m_window, FALSE);
     m_visible = false;
 
-    std::string prevAddr = m_previousWindowAddress;
-    ClipboardManager* mgr = &m_manager;
-
-    std::thread([this, uuid, itemType, prevAddr, mgr]() {
-        if (!prevAddr.empty())
-            exec("hyprctl dispatch focuswindow address:" + prevAddr);
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(150));
-        WindowInfo win = getActiveWindowInfo();
-        mgr->paste(uuid);
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    // The window snapshot from the show request; without one (shown by
+    // another tool) it is asked from Hyprland once focus is back
+    UIWindow target = m_showRequest.window;
+    bool known = m_showRequest.hasWindow;
+
+    // Each step waits for the one before to be confirmed: focus by
+    // Hyprland's activewindowv2 event, the new selection by the daemon's
+    // paste reply. Blocking steps run on worker threads; the daemon call
+    // itself hops back to the main loop that owns the socket. The workers
+    // use `this` only there, once `alive` says it still exists.
+    std::thread([this, alive = m_alive, uuids = std::move(uuids), itemType, target, known,
+                 events]() {
+        UIWindow active;
+        if (!target.address.empty()) {
+            hyprlandRequest("/dispatch focuswindow address:" + target.address);
+            // Closing the layer-shell popup hands keyboard focus back to a
+            // window that never lost it as the active one: no event follows
+            active = getActiveWindowInfo();
+            if (!sameWindow(active.address, target.address)) {
+                if (events == -1)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(FOCUS_SETTLE_MS));
+                else
+                    waitForActiveWindow(events, target.address, FOCUS_TIMEOUT_MS);  // timed out: go on
+                active = {};
+            }
+        }
+        if (events != -1) close(events);
+        UIWindow win = known ? target : active.address.empty() ? getActiveWindowInfo() : active;
+
+        runOnMainThread([this, alive, uuids, itemType, win]() {
+            if (!*alive) return;
+            m_manager.paste(uuids, [this, alive, itemType, win](bool ok) {
+                if (!ok || !*alive) return;  // clipboard unchanged: don't paste stale content
+                PasteStrategy strategy = m_classifier.classify(win);
+                std::thread(sendPasteKeys, strategy, win.xwayland, itemType).detach();
+            });
+        });
+    }).detach();
+}
 
-        bool xw = win.xwayland;
+void ClipboardRenderer::sendPasteKeys(PasteStrategy strategy, bool xw, const std::string& itemType) {
+    // Terminal shortcuts are for text; anything else pastes as in any app
+    if (itemType != "text" && (strategy == PasteStrategy::Kitty || strategy == PasteStrategy::Terminal))
+        strategy = PasteStrategy::Default;
 
-        if (isKittyTerminal(win) && itemType == "text") {
-            if (system("kitty @ send-text --from-clipboard 2>/dev/null") == 0) return;
-        }
+    if (strategy == PasteStrategy::Kitty) {
+        if (system("kitty @ send-text --from-clipboard 2>/dev/null") == 0) return;
+        strategy = PasteStrategy::Terminal;  // remote control off: its shortcut
+    }
 
-        if (isTerminal(win) && itemType == "text") {
+    switch (strategy) {
+        case PasteStrategy::Terminal:
             exec(xw ? "xdotool key --clearmodifiers ctrl+shift+v"
                      : "wtype -d 20 -M ctrl -M shift -k v");
-        } else if (isBrowser(win)) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            break;
+        case PasteStrategy::Browser:
             exec(xw ? "xdotool key --clearmodifiers ctrl+v"
                      : "wtype -d 25 -M ctrl -k v");
-        } else {
+            break;
+        default:
             exec(xw ? "xdotool key --clearmodifiers ctrl+v"
                      : "wtype -d 15 -M ctrl -k v");
-        }
-    }).detach();
+    }
 }
 
 // ── Window detection (1:1 from AGS) ─────────────────────────────────────────
 
-ClipboardRenderer::WindowInfo ClipboardRenderer::getActiveWindowInfo() {
-    WindowInfo info;
-    std::string json = exec("hyprctl activewindow -j 2>/dev/null");
+UIWindow ClipboardRenderer::getActiveWindowInfo() {
+    UIWindow info;
+    std::string json = hyprlandRequest("j/activewindow");
     if (json.empty()) return info;
 
     auto extract = [&](const std::string& key) -> std::string {
@@ -822,57 +1396,26 @@ ClipboardRenderer::WindowInfo ClipboardRenderer::getActiveWindowInfo() {
     return info;
 }
 
-bool ClipboardRenderer::isKittyTerminal(const WindowInfo& win) {
-    if (toLower(win.initialTitle) == "kitty") return true;
-    if (win.pid > 0) {
-        if (toLower(exec("cat /proc/" + std::to_string(win.pid) + "/comm 2>/dev/null")) == "kitty")
-            return true;
-    }
-    return false;
-}
-
-bool ClipboardRenderer::isTerminal(const WindowInfo& win) {
-    std::vector<std::string> fields = {
-        toLower(win.windowClass), toLower(win.initialClass),
-        toLower(win.title), toLower(win.initialTitle)
-    };
-    for (const auto& f : fields) {
-        if (f.empty()) continue;
-        for (const auto& t : TERMINAL_IDENTIFIERS)
-            if (f.find(t) != std::string::npos) return true;
-    }
-    if (win.pid > 0) {
-        std::string comm = toLower(exec("cat /proc/" + std::to_string(win.pid) + "/comm 2>/dev/null"));
-        for (const auto& t : TERMINAL_IDENTIFIERS)
-            if (comm.find(t) != std::string::npos) return true;
-    }
-    return false;
-}
-
-bool ClipboardRenderer::isBrowser(const WindowInfo& win) {
-    std::string cls = toLower(win.windowClass);
-    for (const auto& b : BROWSER_IDENTIFIERS)
-        if (cls.find(b) != std::string::npos) return true;
-    return false;
-}
-
 // ── Positioning ─────────────────────────────────────────────────────────────
 
 void ClipboardRenderer::repositionWindow() {
     if (!m_window) return;
 
-    // Parse caret position file: caretX,caretY[,monX,monY,monW,monH]
+    // Caret and monitor from the plugin's show request; no caret found:
+    // the monitor's center
     int cx = 400, cy = 400;
     int monX = 0, monY = 0, monW = 0, monH = 0;
-    {
-        std::ifstream f(m_config.caretPosFile);
-        if (f.is_open()) {
-            char c;
-            f >> cx >> c >> cy;
-            if (f.peek() == ',') {
-                f >> c >> monX >> c >> monY >> c >> monW >> c >> monH;
-            }
-        }
+    if (m_showRequest.hasMonitor) {
+        monX = m_showRequest.monX;
+        monY = m_showRequest.monY;
+        monW = m_showRequest.monW;
+        monH = m_showRequest.monH;
+        cx = monX + monW / 2;
+        cy = monY + monH / 2;
+    }
+    if (m_showRequest.hasCaret) {
+        cx = m_showRequest.caretX;
+        cy = m_showRequest.caretY;
     }
 
     // If no monitor bounds from plugin, get them from GTK display
@@ -901,6 +1444,10 @@ void ClipboardRenderer::repositionWindow() {
                 g_object_unref(mon);
             }
         }
+        if (!m_showRequest.hasCaret) {
+            cx = monX + monW / 2;
+            cy = monY + monH / 2;
+        }
     }
 
     // Clamp caret to monitor bounds before applying offset
@@ -997,17 +1544,21 @@ void ClipboardRenderer::saveCaretOffset() {
 
 // ── Public API ──────────────────────────────────────────────────────────────
 
-void ClipboardRenderer::show() {
-    if (m_window && !m_visible) { gtk_window_present(GTK_WINDOW(m_window)); m_visible = true; }
+void ClipboardRenderer::show(const UIMessage& request) {
+    if (!m_window || m_visible) return;
+    m_showRequest = request;
+    m_showRequestTime = request.since;
+    m_visible = true;
+    gtk_window_present(GTK_WINDOW(m_window));
 }
 
 void ClipboardRenderer::hide() {
     if (m_window && m_visible) { gtk_widget_set_visible(m_window, FALSE); m_visible = false; }
 }
 
-void ClipboardRenderer::toggle() {
+void ClipboardRenderer::toggle(const UIMessage& request) {
     if (!m_window) return;
-    if (m_visible) hide(); else show();
+    if (m_visible) hide(); else show(request);
 }
 
 bool ClipboardRenderer::isVisible() const { return m_visible; }
@@ -1022,4 +1573,24 @@ void ClipboardRenderer::setOffset(int x, int y) {
 
 void ClipboardRenderer::refresh() { updateList(); }
 
+std::string ClipboardRenderer::stats() const {
+    return "{\"list_cache_hits\":" + std::to_string(m_listCache.hits()) +
+           ",\"list_cache_misses\":" + std::to_string(m_listCache.misses()) +
+           ",\"list_cache_entries\":" + std::to_string(m_listCache.size()) +
+           ",\"generation\":" + std::to_string(m_manager.generation()) +
+           ",\"history_synced\":" + (m_history.synced() ? "true" : "false") +
+           ",\"history_items\":" + std::to_string(m_history.size()) +
+           ",\"history_bytes\":" + std::to_string(m_history.snapshot()->memoryUsage()) +
+           ",\"history_generation\":" + std::to_string(m_history.generation()) +
+           ",\"thumbnails\":" + std::to_string(m_thumbnails.size()) +
+           ",\"thumbnail_bytes\":" + std::to_string(m_thumbnails.bytes()) +
+           ",\"thumbnail_hits\":" + std::to_string(m_thumbnails.hits()) +
+           ",\"thumbnail_misses\":" + std::to_string(m_thumbnails.misses()) +
+           ",\"thumbnail_decodes\":" + std::to_string(m_thumbnails.decodes()) +
+           ",\"search_latency\":" + m_searchLatency.toJson() +
+           ",\"shows\":" + std::to_string(m_shows) +
+           ",\"shows_prepared\":" + std::to_string(m_showsPrepared) +
+           ",\"show_latency\":" + m_showLatency.toJson() + "}";
+}
+
 } // namespace hyprclipx
@@ -54,6 +54,24 @@ static std::string parseString(const std::string& value) {
     return v;
 }
 
+// "a" or ["a", "b"] (no commas inside the strings)
+static std::vector<std::string> parseStringList(const std::string& value) {
+    std::string v = trim(value);
+    if (v.size() < 2 || v.front() != '[' || v.back() != ']') return {parseString(v)};
+    std::vector<std::string> items;
+    std::stringstream ss(v.substr(1, v.size() - 2));
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!trim(item).empty()) items.push_back(parseString(item));
+    return items;
+}
+
+static std::string joinStringList(const std::vector<std::string>& items) {
+    std::string out = "[";
+    for (size_t i = 0; i < items.size(); i++) out += (i ? ", \"" : "\"") + items[i] + "\"";
+    return out + "]";
+}
+
 static int parseInt(const std::string& value) {
     try {
         return std::stoi(trim(value));
@@ -72,10 +90,15 @@ Config loadConfig() {
     }
 
     std::string line;
+    PasteRule* rule = nullptr;  // inside a [[paste_rule]] table
     while (std::getline(file, line)) {
         line = trim(line);
 
-        if (line.empty() || line[0] == '#' || line[0] == '[') {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (line[0] == '[') {
+            rule = line == "[[paste_rule]]" ? &config.pasteRules.emplace_back() : nullptr;
             continue;
         }
 
@@ -85,13 +108,27 @@ Config loadConfig() {
         std::string key = trim(line.substr(0, eq));
         std::string value = trim(line.substr(eq + 1));
 
+        if (rule) {
+            if (key == "class") rule->classes = parseStringList(value);
+            else if (key == "title") rule->titles = parseStringList(value);
+            else if (key == "comm") rule->comms = parseStringList(value);
+            else if (key == "any") rule->any = parseStringList(value);
+            else if (key == "xwayland") rule->xwayland = trim(value) == "true";
+            else if (key == "paste") rule->paste = parseString(value);
+            continue;
+        }
+
         if (key == "window_width") config.windowWidth = parseInt(value);
         else if (key == "window_height") config.windowHeight = parseInt(value);
         else if (key == "offset_x") config.offsetX = parseInt(value);
         else if (key == "offset_y") config.offsetY = parseInt(value);
         else if (key == "max_items") config.maxItems = parseInt(value);
         else if (key == "hotkey") config.hotkey = parseString(value);
+        else if (key == "search_mode") config.searchMode = parseString(value);
         else if (key == "socket_path") config.socketPath = parseString(value);
+        else if (key == "selection_socket") config.selectionSocket = parseString(value);
+        else if (key == "ui_socket") config.uiSocket = parseString(value);
+        else if (key == "caret_socket") config.caretSocket = parseString(value);
     }
 
     return config;
@@ -118,7 +155,21 @@ bool saveConfig(const Config& config) {
     file << "[general]\n";
     file << "hotkey = \"" << config.hotkey << "\"\n";
     file << "max_items = " << config.maxItems << "\n";
+    file << "search_mode = \"" << config.searchMode << "\"\n";
     file << "socket_path = \"" << config.socketPath << "\"\n";
+    file << "selection_socket = \"" << config.selectionSocket << "\"\n";
+    file << "ui_socket = \"" << config.uiSocket << "\"\n";
+    file << "caret_socket = \"" << config.caretSocket << "\"\n";
+
+    for (const auto& rule : config.pasteRules) {
+        file << "\n[[paste_rule]]\n";
+        if (!rule.classes.empty()) file << "class = " << joinStringList(rule.classes) << "\n";
+        if (!rule.titles.empty()) file << "title = " << joinStringList(rule.titles) << "\n";
+        if (!rule.comms.empty()) file << "comm = " << joinStringList(rule.comms) << "\n";
+        if (!rule.any.empty()) file << "any = " << joinStringList(rule.any) << "\n";
+        if (rule.xwayland != -1) file << "xwayland = " << (rule.xwayland ? "true" : "false") << "\n";
+        file << "paste = \"" << rule.paste << "\"\n";
+    }
 
     return true;
 }
@@ -0,0 +1,171 @@
+// List model for the GtkListView (see EntryListModel.hpp)
+
+#include "hyprclipx/EntryListModel.hpp"
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <unordered_map>
+
+using hyprclipx::ClipboardEntry;
+
+// ============================================================================
+// Item: one row's entry
+// ============================================================================
+
+G_DECLARE_FINAL_TYPE(HyprclipxEntryItem, hyprclipx_entry_item, HYPRCLIPX, ENTRY_ITEM, GObject)
+
+struct _HyprclipxEntryItem {
+    GObject parent_instance;
+    ClipboardEntry* entry;
+};
+
+G_DEFINE_TYPE(HyprclipxEntryItem, hyprclipx_entry_item, G_TYPE_OBJECT)
+
+static void hyprclipx_entry_item_finalize(GObject* object) {
+    delete HYPRCLIPX_ENTRY_ITEM(object)->entry;
+    G_OBJECT_CLASS(hyprclipx_entry_item_parent_class)->finalize(object);
+}
+
+static void hyprclipx_entry_item_class_init(HyprclipxEntryItemClass* klass) {
+    G_OBJECT_CLASS(klass)->finalize = hyprclipx_entry_item_finalize;
+}
+
+static void hyprclipx_entry_item_init(HyprclipxEntryItem* self) {
+    self->entry = nullptr;
+}
+
+// ============================================================================
+// Model: a view of the renderer's rows
+// ============================================================================
+
+G_DECLARE_FINAL_TYPE(HyprclipxEntryList, hyprclipx_entry_list, HYPRCLIPX, ENTRY_LIST, GObject)
+
+struct _HyprclipxEntryList {
+    GObject parent_instance;
+    const std::vector<ClipboardEntry>* items;
+};
+
+static void hyprclipx_entry_list_model_init(GListModelInterface* iface);
+
+G_DEFINE_TYPE_WITH_CODE(HyprclipxEntryList, hyprclipx_entry_list, G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(G_TYPE_LIST_MODEL, hyprclipx_entry_list_model_init))
+
+static GType hyprclipx_entry_list_get_item_type(GListModel*) {
+    return hyprclipx_entry_item_get_type();
+}
+
+static guint hyprclipx_entry_list_get_n_items(GListModel* model) {
+    return static_cast<guint>(HYPRCLIPX_ENTRY_LIST(model)->items->size());
+}
+
+static gpointer hyprclipx_entry_list_get_item(GListModel* model, guint position) {
+    const auto& items = *HYPRCLIPX_ENTRY_LIST(model)->items;
+    if (position >= items.size()) return nullptr;
+    auto* item = HYPRCLIPX_ENTRY_ITEM(g_object_new(hyprclipx_entry_item_get_type(), nullptr));
+    item->entry = new ClipboardEntry(items[position]);
+    return item;
+}
+
+static void hyprclipx_entry_list_model_init(GListModelInterface* iface) {
+    iface->get_item_type = hyprclipx_entry_list_get_item_type;
+    iface->get_n_items = hyprclipx_entry_list_get_n_items;
+    iface->get_item = hyprclipx_entry_list_get_item;
+}
+
+static void hyprclipx_entry_list_class_init(HyprclipxEntryListClass*) {}
+
+static void hyprclipx_entry_list_init(HyprclipxEntryList* self) {
+    self->items = nullptr;
+}
+
+namespace hyprclipx {
+
+GListModel* entryListModelNew(const std::vector<ClipboardEntry>* items) {
+    auto* model = HYPRCLIPX_ENTRY_LIST(g_object_new(hyprclipx_entry_list_get_type(), nullptr));
+    model->items = items;
+    return G_LIST_MODEL(model);
+}
+
+void entryListModelChanged(GListModel* model, guint position, guint removed, guint added) {
+    if (removed || added) g_list_model_items_changed(model, position, removed, added);
+}
+
+void entryListModelReconcile(GListModel* model, std::vector<ClipboardEntry>& items,
+                             std::vector<ClipboardEntry> next) {
+    constexpr size_t NONE = static_cast<size_t>(-1);
+
+    // Old position of each new row's uuid
+    std::vector<size_t> source(next.size(), NONE);
+    {
+        std::unordered_map<std::string_view, size_t> oldPos;
+        oldPos.reserve(items.size());
+        for (size_t i = 0; i < items.size(); i++) oldPos.emplace(items[i].uuid, i);
+        for (size_t j = 0; j < next.size(); j++) {
+            auto it = oldPos.find(next[j].uuid);
+            if (it != oldPos.end()) source[j] = it->second;
+        }
+    }
+
+    // Rows that stay put relative to each other: the longest run of new rows
+    // whose old positions increase. Everything else is removed / inserted.
+    std::vector<size_t> tails, prev(next.size(), NONE);
+    for (size_t j = 0; j < next.size(); j++) {
+        if (source[j] == NONE) continue;
+        auto it = std::lower_bound(tails.begin(), tails.end(), source[j],
+                                   [&](size_t t, size_t pos) { return source[t] < pos; });
+        if (it != tails.begin()) prev[j] = *(it - 1);
+        if (it == tails.end()) tails.push_back(j);
+        else *it = j;
+    }
+    std::vector<bool> keepOld(items.size(), false), keepNew(next.size(), false);
+    for (size_t j = tails.empty() ? NONE : tails.back(); j != NONE; j = prev[j]) {
+        keepOld[source[j]] = true;
+        keepNew[j] = true;
+    }
+
+    if (tails.empty()) {
+        auto removed = static_cast<guint>(items.size());
+        items = std::move(next);
+        entryListModelChanged(model, 0, removed, static_cast<guint>(items.size()));
+        return;
+    }
+
+    // Removals, back to front so the positions ahead stay valid
+    for (size_t i = items.size(); i-- > 0;) {
+        if (keepOld[i]) continue;
+        size_t end = i + 1;
+        while (i > 0 && !keepOld[i - 1]) i--;
+        items.erase(items.begin() + static_cast<ptrdiff_t>(i), items.begin() + static_cast<ptrdiff_t>(end));
+        entryListModelChanged(model, static_cast<guint>(i), static_cast<guint>(end - i), 0);
+    }
+
+    // Insertions and changed rows, front to back: items[0, j) matches
+    // next[0, j), the kept rows follow in order
+    for (size_t j = 0; j < next.size();) {
+        size_t start = j;
+        if (!keepNew[j]) {
+            while (j < next.size() && !keepNew[j]) j++;
+            items.insert(items.begin() + static_cast<ptrdiff_t>(start),
+                         std::make_move_iterator(next.begin() + static_cast<ptrdiff_t>(start)),
+                         std::make_move_iterator(next.begin() + static_cast<ptrdiff_t>(j)));
+            entryListModelChanged(model, static_cast<guint>(start), 0, static_cast<guint>(j - start));
+            continue;
+        }
+        while (j < next.size() && keepNew[j] && !(items[j] == next[j])) {
+            items[j] = std::move(next[j]);
+            j++;
+        }
+        if (j > start) {
+            auto count = static_cast<guint>(j - start);
+            entryListModelChanged(model, static_cast<guint>(start), count, count);
+        } else {
+            j++;
+        }
+    }
+}
+
+const ClipboardEntry& entryListItemEntry(gpointer item) {
+    return *HYPRCLIPX_ENTRY_ITEM(item)->entry;
+}
+
+} // namespace hyprclipx
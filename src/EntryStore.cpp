@@ -0,0 +1,380 @@
+// Columnar clipboard history snapshot (see EntryStore.hpp)
+
+#include "hyprclipx/EntryStore.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <unordered_map>
+
+namespace hyprclipx {
+
+// ============================================================================
+// Field encodings
+// ============================================================================
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;  // uppercase too: such ids are kept verbatim, so they round-trip
+}
+
+std::optional<Uuid> Uuid::parse(std::string_view text) {
+    if (text.size() != 36) return std::nullopt;
+    Uuid id;
+    int nibbles = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        if (i == 8 || i == 13 || i == 18 || i == 23) {
+            if (text[i] != '-') return std::nullopt;
+            continue;
+        }
+        int v = hexValue(text[i]);
+        if (v < 0) return std::nullopt;
+        uint64_t& half = nibbles < 16 ? id.hi : id.lo;
+        half = (half << 4) | static_cast<uint64_t>(v);
+        nibbles++;
+    }
+    return id;
+}
+
+std::string Uuid::toString() const {
+    static const char HEX[] = "0123456789abcdef";
+    std::string out;
+    out.reserve(36);
+    for (int i = 0; i < 32; i++) {
+        if (i == 8 || i == 12 || i == 16 || i == 20) out += '-';
+        uint64_t half = i < 16 ? hi : lo;
+        out += HEX[(half >> (60 - 4 * (i % 16))) & 0xf];
+    }
+    return out;
+}
+
+// "YYYY-MM-DD HH:MM:SS" (SQLite CURRENT_TIMESTAMP, UTC) → Unix seconds
+static int64_t parseTimestamp(std::string_view s) {
+    if (s.size() < 19 || s[4] != '-' || s[7] != '-' || s[13] != ':' || s[16] != ':')
+        return 0;
+    auto field = [&](size_t pos, size_t len) {
+        int v = -1;
+        auto [end, ec] = std::from_chars(s.data() + pos, s.data() + pos + len, v);
+        return (ec == std::errc{} && end == s.data() + pos + len) ? v : -1;
+    };
+    int y = field(0, 4), mo = field(5, 2), d = field(8, 2);
+    int h = field(11, 2), mi = field(14, 2), sec = field(17, 2);
+    if (y < 0 || mo < 0 || d < 0 || h < 0 || mi < 0 || sec < 0) return 0;
+
+    using namespace std::chrono;
+    year_month_day ymd{year{y}, month{static_cast<unsigned>(mo)}, day{static_cast<unsigned>(d)}};
+    if (!ymd.ok()) return 0;
+    return duration_cast<seconds>(sys_days{ymd}.time_since_epoch()).count() +
+           h * 3600 + mi * 60 + sec;
+}
+
+static std::string formatTimestamp(int64_t epoch) {
+    if (epoch == 0) return "";
+    using namespace std::chrono;
+    sys_seconds tp{seconds{epoch}};
+    auto dayStart = floor<days>(tp);
+    year_month_day ymd{dayStart};
+    hh_mm_ss hms{tp - dayStart};
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%04d-%02u-%02u %02d:%02d:%02d",
+             static_cast<int>(ymd.year()), static_cast<unsigned>(ymd.month()),
+             static_cast<unsigned>(ymd.day()), static_cast<int>(hms.hours().count()),
+             static_cast<int>(hms.minutes().count()), static_cast<int>(hms.seconds().count()));
+    return buf;
+}
+
+// ============================================================================
+// Builder
+// ============================================================================
+
+EntryStore::Builder::Builder() : m_store(new EntryStore) {}
+
+void EntryStore::Builder::reserve(size_t rows, size_t arenaBytes, size_t thumbs,
+                                  size_t extraBytes) {
+    EntryStore& s = *m_store;
+    s.m_ids.reserve(rows);
+    s.m_flags.reserve(rows);
+    s.m_created.reserve(rows);
+    s.m_previewEnds.reserve(rows);
+    s.m_arena.reserve(arenaBytes);
+    s.m_thumbs.reserve(thumbs);
+    s.m_extra.reserve(extraBytes);
+}
+
+void EntryStore::Builder::append(const ClipboardEntry& entry) {
+    EntryStore& s = *m_store;
+
+    uint8_t flags = 0;
+    if (entry.type == "image") flags |= IMAGE;
+    if (entry.favorite) flags |= FAVORITE;
+    if (!entry.thumb.empty()) flags |= THUMB;
+    if (entry.fullPreview) flags |= FULL;
+
+    Uuid id;
+    if (auto parsed = Uuid::parse(entry.uuid)) {
+        id = *parsed;
+    } else {
+        Span raw = s.storeExtra(entry.uuid);
+        id = {raw.offset, raw.length};
+        flags |= RAW_ID;
+    }
+
+    // Before 1970 or past 2106: not a timestamp the daemon writes
+    int64_t created = parseTimestamp(entry.createdAt);
+    if (created < 0 || created > UINT32_MAX) created = 0;
+    s.pushRow(id, flags, static_cast<uint32_t>(created), entry.preview);
+
+    // Thumbnails all live in the daemon's thumbs/ directory: keep that once
+    if (flags & THUMB) {
+        std::string_view thumb = entry.thumb;
+        size_t slash = thumb.rfind('/');
+        size_t split = slash == std::string_view::npos ? 0 : slash + 1;
+        s.pushThumb(thumb.substr(0, split), thumb.substr(split));
+    }
+}
+
+void EntryStore::Builder::appendRow(const EntryStore& from, size_t row,
+                                    std::optional<bool> favorite) {
+    EntryStore& s = *m_store;
+
+    uint8_t flags = from.m_flags[row];
+    if (favorite) flags = static_cast<uint8_t>(*favorite ? (flags | FAVORITE) : (flags & ~FAVORITE));
+
+    Uuid id = from.m_ids[row];
+    if (flags & RAW_ID) {
+        Span raw = s.storeExtra(from.rawId(row));
+        id = {raw.offset, raw.length};
+    }
+
+    s.pushRow(id, flags, from.m_created[row], from.preview(row));
+    if (const Thumb* t = from.thumbOf(row)) s.pushThumb(from.m_dirs[t->dir], from.extra(t->name));
+}
+
+size_t EntryStore::Builder::size() const {
+    return m_store->size();
+}
+
+std::shared_ptr<const EntryStore> EntryStore::Builder::build() {
+    m_store->shrink();
+    std::shared_ptr<const EntryStore> done = std::move(m_store);
+    m_store.reset(new EntryStore);
+    return done;
+}
+
+std::shared_ptr<const EntryStore> EntryStore::empty() {
+    static const std::shared_ptr<const EntryStore> none = Builder().build();
+    return none;
+}
+
+// ============================================================================
+// Storage
+// ============================================================================
+
+EntryStore::Span EntryStore::storeExtra(std::string_view text) {
+    Span span{static_cast<uint32_t>(m_extra.size()), static_cast<uint32_t>(text.size())};
+    m_extra.append(text);
+    return span;
+}
+
+std::string_view EntryStore::extra(Span span) const {
+    return std::string_view(m_extra).substr(span.offset, span.length);
+}
+
+std::string_view EntryStore::rawId(size_t row) const {
+    return extra({static_cast<uint32_t>(m_ids[row].hi), static_cast<uint32_t>(m_ids[row].lo)});
+}
+
+const EntryStore::Thumb* EntryStore::thumbOf(size_t row) const {
+    if (!(m_flags[row] & THUMB)) return nullptr;
+    auto it = std::lower_bound(m_thumbs.begin(), m_thumbs.end(), row,
+        [](const Thumb& t, size_t r) { return t.row < r; });
+    return it != m_thumbs.end() && it->row == row ? &*it : nullptr;
+}
+
+uint32_t EntryStore::internDir(std::string_view dir) {
+    // A handful of distinct directories at most; linear scan is fine
+    auto it = std::find(m_dirs.begin(), m_dirs.end(), dir);
+    if (it == m_dirs.end()) it = m_dirs.emplace(m_dirs.end(), dir);
+    return static_cast<uint32_t>(it - m_dirs.begin());
+}
+
+void EntryStore::pushRow(Uuid id, uint8_t flags, uint32_t created, std::string_view preview) {
+    m_ids.push_back(id);
+    m_flags.push_back(flags);
+    m_created.push_back(created);
+    m_arena.append(preview);
+    m_previewEnds.push_back(static_cast<uint32_t>(m_arena.size()));
+}
+
+// Thumbnail of the row just pushed
+void EntryStore::pushThumb(std::string_view dir, std::string_view name) {
+    m_thumbs.push_back({static_cast<uint32_t>(size() - 1), internDir(dir), storeExtra(name)});
+}
+
+// Growth left over from appending: worth a reallocation once it is more
+// than an eighth of what is used (stores built from a reserve() are exact)
+void EntryStore::shrink() {
+    auto fit = [](auto& v) {
+        if (v.capacity() - v.size() > v.size() / 8) v.shrink_to_fit();
+    };
+    fit(m_ids);
+    fit(m_flags);
+    fit(m_created);
+    fit(m_previewEnds);
+    fit(m_arena);
+    fit(m_extra);
+    fit(m_thumbs);
+}
+
+// ============================================================================
+// Access
+// ============================================================================
+
+std::string EntryStore::uuid(size_t row) const {
+    if (m_flags[row] & RAW_ID) return std::string(rawId(row));
+    return m_ids[row].toString();
+}
+
+EntryType EntryStore::type(size_t row) const {
+    return (m_flags[row] & IMAGE) ? EntryType::Image : EntryType::Text;
+}
+
+bool EntryStore::favorite(size_t row) const {
+    return m_flags[row] & FAVORITE;
+}
+
+std::string_view EntryStore::preview(size_t row) const {
+    uint32_t start = row ? m_previewEnds[row - 1] : 0;
+    return std::string_view(m_arena).substr(start, m_previewEnds[row] - start);
+}
+
+std::string EntryStore::thumb(size_t row) const {
+    const Thumb* t = thumbOf(row);
+    if (!t) return "";
+    return m_dirs[t->dir] + std::string(extra(t->name));
+}
+
+int64_t EntryStore::createdAt(size_t row) const {
+    return m_created[row];
+}
+
+ClipboardEntry EntryStore::entry(size_t row) const {
+    ClipboardEntry e;
+    e.uuid = uuid(row);
+    e.type = type(row) == EntryType::Image ? "image" : "text";
+    e.preview = preview(row);
+    e.thumb = thumb(row);
+    e.favorite = favorite(row);
+    e.createdAt = formatTimestamp(m_created[row]);
+    e.fullPreview = m_flags[row] & FULL;
+    return e;
+}
+
+std::optional<size_t> EntryStore::find(std::string_view uuid) const {
+    auto id = Uuid::parse(uuid);
+    for (size_t row = 0; row < size(); row++) {
+        bool raw = m_flags[row] & RAW_ID;
+        if (id ? (!raw && m_ids[row] == *id) : (raw && rawId(row) == uuid)) return row;
+    }
+    return std::nullopt;
+}
+
+size_t EntryStore::memoryUsage() const {
+    size_t bytes = m_ids.capacity() * sizeof(Uuid) + m_flags.capacity() +
+                   m_created.capacity() * sizeof(uint32_t) +
+                   m_previewEnds.capacity() * sizeof(uint32_t) +
+                   m_arena.capacity() + m_extra.capacity() +
+                   m_thumbs.capacity() * sizeof(Thumb) +
+                   m_dirs.capacity() * sizeof(std::string);
+    for (const auto& dir : m_dirs) bytes += dir.capacity();
+    return bytes;
+}
+
+// ============================================================================
+// Changes → next store
+// ============================================================================
+
+namespace {
+
+struct UuidHash {
+    size_t operator()(const Uuid& id) const {
+        return std::hash<uint64_t>{}(id.hi ^ (id.lo * 0x9e3779b97f4a7c15ull));
+    }
+};
+
+// Net effect of a change list on one row of the previous store
+struct Touch {
+    bool removed = false;           // deleted, or replaced by a row on top
+    std::optional<bool> favorite;
+};
+
+class TouchMap {
+public:
+    Touch& operator[](std::string_view uuid) {
+        if (auto id = Uuid::parse(uuid)) return m_ids[*id];
+        return m_raw[std::string(uuid)];
+    }
+    const Touch* find(const Uuid& id) const {
+        auto it = m_ids.find(id);
+        return it == m_ids.end() ? nullptr : &it->second;
+    }
+    const Touch* findRaw(std::string_view uuid) const {
+        auto it = m_raw.find(uuid);
+        return it == m_raw.end() ? nullptr : &it->second;
+    }
+
+private:
+    std::unordered_map<Uuid, Touch, UuidHash> m_ids;
+    std::map<std::string, Touch, std::less<>> m_raw;
+};
+
+} // namespace
+
+std::shared_ptr<const EntryStore> EntryStore::withChanges(
+        const std::vector<HistoryChange>& changes) const {
+    // Fold the changes first, so the rows are copied in a single pass
+    std::vector<ClipboardEntry> top;  // inserted / updated, oldest first
+    TouchMap touched;
+    size_t topBytes = 0;
+    size_t topExtra = 0;  // at most: thumbnail names and raw uuids
+
+    for (const auto& change : changes) {
+        const std::string& uuid = change.item.uuid;
+        auto inTop = std::find_if(top.begin(), top.end(),
+            [&](const ClipboardEntry& e) { return e.uuid == uuid; });
+        switch (change.op) {
+            case HistoryChange::Op::Insert:
+            case HistoryChange::Op::Update:
+                if (inTop != top.end()) top.erase(inTop);
+                top.push_back(change.item);
+                topBytes += change.item.preview.size();
+                topExtra += change.item.thumb.size() + change.item.uuid.size();
+                touched[uuid].removed = true;
+                break;
+            case HistoryChange::Op::Delete:
+                if (inTop != top.end()) top.erase(inTop);
+                touched[uuid].removed = true;
+                break;
+            case HistoryChange::Op::Favorite:
+                if (inTop != top.end()) inTop->favorite = change.item.favorite;
+                else touched[uuid].favorite = change.item.favorite;
+                break;
+        }
+    }
+
+    Builder next;
+    next.reserve(size() + top.size(), m_arena.size() + topBytes,
+                 m_thumbs.size() + top.size(), m_extra.size() + topExtra);
+    for (auto it = top.rbegin(); it != top.rend(); ++it) next.append(*it);
+    for (size_t row = 0; row < size(); row++) {
+        const Touch* t = (m_flags[row] & RAW_ID) ? touched.findRaw(rawId(row))
+                                                 : touched.find(m_ids[row]);
+        if (t && t->removed) continue;
+        next.appendRow(*this, row, t ? t->favorite : std::nullopt);
+    }
+    return next.build();
+}
+
+} // namespace hyprclipx
@@ -0,0 +1,58 @@
+// Length-prefixed framing for the clipman-daemon socket
+
+#include "hyprclipx/Framing.hpp"
+
+namespace hyprclipx {
+
+static constexpr size_t HEADER_SIZE = 4;
+
+std::string encodeFrame(std::string_view payload) {
+    uint32_t len = static_cast<uint32_t>(payload.size());
+    std::string frame;
+    frame.reserve(HEADER_SIZE + payload.size());
+    frame += static_cast<char>((len >> 24) & 0xff);
+    frame += static_cast<char>((len >> 16) & 0xff);
+    frame += static_cast<char>((len >> 8) & 0xff);
+    frame += static_cast<char>(len & 0xff);
+    frame.append(payload);
+    return frame;
+}
+
+static uint32_t readHeader(const char* p) {
+    auto b = [&](int i) { return static_cast<uint32_t>(static_cast<unsigned char>(p[i])); };
+    return (b(0) << 24) | (b(1) << 16) | (b(2) << 8) | b(3);
+}
+
+bool FrameDecoder::feed(const char* data, size_t len) {
+    // Compact before growing so the buffer stays around one frame in size
+    if (m_pos > 0 && m_pos == m_buf.size()) {
+        m_buf.clear();
+        m_pos = 0;
+    } else if (m_pos > 65536 && m_pos * 2 > m_buf.size()) {
+        m_buf.erase(0, m_pos);
+        m_pos = 0;
+    }
+    m_buf.append(data, len);
+
+    if (m_buf.size() - m_pos >= HEADER_SIZE &&
+        readHeader(m_buf.data() + m_pos) > MAX_FRAME_SIZE)
+        return false;
+    return true;
+}
+
+bool FrameDecoder::next(std::string& payload) {
+    if (m_buf.size() - m_pos < HEADER_SIZE) return false;
+    uint32_t len = readHeader(m_buf.data() + m_pos);
+    if (m_buf.size() - m_pos - HEADER_SIZE < len) return false;
+
+    payload.assign(m_buf, m_pos + HEADER_SIZE, len);
+    m_pos += HEADER_SIZE + len;
+    return true;
+}
+
+void FrameDecoder::reset() {
+    m_buf.clear();
+    m_pos = 0;
+}
+
+} // namespace hyprclipx
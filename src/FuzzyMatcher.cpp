@@ -0,0 +1,354 @@
+// Fuzzy matching and scoring (see FuzzyMatcher.hpp)
+
+#include "hyprclipx/FuzzyMatcher.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HYPRCLIPX_X86 1
+#endif
+
+namespace hyprclipx {
+
+// ============================================================================
+// Scoring constants (fzf's)
+// ============================================================================
+
+static constexpr int SCORE_MATCH               = 16;
+static constexpr int SCORE_GAP_START           = -3;
+static constexpr int SCORE_GAP_EXTENSION       = -1;
+static constexpr int BONUS_BOUNDARY            = SCORE_MATCH / 2;
+static constexpr int BONUS_BOUNDARY_WHITE      = BONUS_BOUNDARY + 2;
+static constexpr int BONUS_BOUNDARY_DELIMITER  = BONUS_BOUNDARY + 1;
+static constexpr int BONUS_NON_WORD            = SCORE_MATCH / 2;
+static constexpr int BONUS_CAMEL123            = BONUS_BOUNDARY - 1;
+static constexpr int BONUS_CONSECUTIVE         = -(SCORE_GAP_START + SCORE_GAP_EXTENSION);
+static constexpr int BONUS_FIRST_CHAR_MULTIPLIER = 2;
+
+// Ordered: everything after Delimiter is part of a word
+enum CharClass : uint8_t { White, NonWord, Delimiter, Lower, Upper, Letter, Number };
+
+// ============================================================================
+// Case folding / character classes
+// ============================================================================
+
+char32_t foldCase(char32_t c) {
+    if (c < 0x80) return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+    // Latin-1
+    if (c >= 0xC0 && c <= 0xDE && c != 0xD7) return c + 32;
+    // Latin Extended-A: upper/lower pairs, upper even except in two runs
+    if (c >= 0x100 && c <= 0x17F) {
+        if (c == 0x130 || c == 0x131 || c == 0x138 || c == 0x149 || c == 0x17F) return c;
+        if (c == 0x178) return 0xFF;
+        if ((c >= 0x139 && c <= 0x148) || (c >= 0x179 && c <= 0x17E)) return (c & 1) ? c + 1 : c;
+        return (c & 1) ? c : c + 1;
+    }
+    // Greek
+    if (c >= 0x391 && c <= 0x3A9 && c != 0x3A2) return c + 32;
+    if (c == 0x386) return 0x3AC;
+    if (c >= 0x388 && c <= 0x38A) return c + 37;
+    if (c == 0x38C) return 0x3CC;
+    if (c == 0x38E || c == 0x38F) return c + 63;
+    if (c == 0x3C2) return 0x3C3;  // final sigma
+    // Cyrillic
+    if (c >= 0x400 && c <= 0x40F) return c + 80;
+    if (c >= 0x410 && c <= 0x42F) return c + 32;
+    if ((c >= 0x460 && c <= 0x481) || (c >= 0x48A && c <= 0x4BF) || (c >= 0x4D0 && c <= 0x52F))
+        return (c & 1) ? c : c + 1;
+    if (c == 0x4C0) return 0x4CF;
+    if (c >= 0x4C1 && c <= 0x4CE) return (c & 1) ? c + 1 : c;
+    // Armenian
+    if (c >= 0x531 && c <= 0x556) return c + 48;
+    // Latin Extended Additional
+    if ((c >= 0x1E00 && c <= 0x1E95) || (c >= 0x1EA0 && c <= 0x1EFF)) return (c & 1) ? c : c + 1;
+    if (c == 0x1E9E) return 0xDF;
+    // Fullwidth Latin
+    if (c >= 0xFF21 && c <= 0xFF3A) return c + 32;
+    return c;
+}
+
+static CharClass classOf(char32_t c) {
+    if (c < 0x80) {
+        if (c >= 'a' && c <= 'z') return Lower;
+        if (c >= 'A' && c <= 'Z') return Upper;
+        if (c >= '0' && c <= '9') return Number;
+        if (c == ' ' || (c >= '\t' && c <= '\r')) return White;
+        if (c == '/' || c == ',' || c == ':' || c == ';' || c == '|') return Delimiter;
+        return NonWord;
+    }
+    if (c == 0xA0 || c == 0x3000 || (c >= 0x2000 && c <= 0x200A)) return White;
+    if ((c >= 0xA1 && c <= 0xBF && c != 0xAA && c != 0xB5 && c != 0xBA) ||
+        c == 0xD7 || c == 0xF7 || (c >= 0x2010 && c <= 0x205E) || (c >= 0x3001 && c <= 0x3003))
+        return NonWord;
+    return foldCase(c) != c ? Upper : Letter;
+}
+
+static int bonusFor(CharClass prev, CharClass cur) {
+    bool prevWord = prev > Delimiter, curWord = cur > Delimiter;
+    if (curWord && !prevWord) {
+        if (prev == White) return BONUS_BOUNDARY_WHITE;
+        if (prev == Delimiter) return BONUS_BOUNDARY_DELIMITER;
+        return BONUS_BOUNDARY;
+    }
+    if ((prev == Lower && cur == Upper) || (prev != Number && cur == Number)) return BONUS_CAMEL123;
+    if (cur == White) return BONUS_BOUNDARY_WHITE;
+    if (!curWord) return BONUS_NON_WORD;
+    return 0;
+}
+
+// Next code point of `s` at `i` (advanced past it); malformed bytes decode
+// to U+FFFD one at a time
+static char32_t decodeUtf8(std::string_view s, size_t& i) {
+    auto b = static_cast<unsigned char>(s[i]);
+    int len = b < 0x80 ? 1 : (b >> 5) == 0x6 ? 2 : (b >> 4) == 0xE ? 3 : (b >> 3) == 0x1E ? 4 : 0;
+    if (len == 0 || i + static_cast<size_t>(len) > s.size()) { i++; return 0xFFFD; }
+    char32_t c = len == 1 ? b : (b & (0x7F >> len));
+    for (int k = 1; k < len; k++) {
+        auto cb = static_cast<unsigned char>(s[i + static_cast<size_t>(k)]);
+        if ((cb & 0xC0) != 0x80) { i++; return 0xFFFD; }
+        c = (c << 6) | (cb & 0x3F);
+    }
+    i += static_cast<size_t>(len);
+    return c;
+}
+
+// ============================================================================
+// Byte scans: first occurrence of either `lo` or `up` in s[i, n), n if none
+// ============================================================================
+
+using FindFn = size_t (*)(const unsigned char* s, size_t i, size_t n, unsigned char lo, unsigned char up);
+// First byte >= 0x80 in s[i, n): where the next non-ASCII character starts
+using FindHighFn = size_t (*)(const unsigned char* s, size_t i, size_t n);
+
+static size_t findScalar(const unsigned char* s, size_t i, size_t n, unsigned char lo, unsigned char up) {
+    for (; i < n; i++)
+        if (s[i] == lo || s[i] == up) return i;
+    return n;
+}
+
+static size_t findHighScalar(const unsigned char* s, size_t i, size_t n) {
+    for (; i < n; i++)
+        if (s[i] >= 0x80) return i;
+    return n;
+}
+
+#ifdef HYPRCLIPX_X86
+__attribute__((target("sse4.2")))
+static size_t findSse42(const unsigned char* s, size_t i, size_t n, unsigned char lo, unsigned char up) {
+    // Both cases in one PCMPESTRI: "equal any" against the set {lo, up}
+    const __m128i set = _mm_setr_epi8(static_cast<char>(lo), static_cast<char>(up),
+                                      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    for (; i + 16 <= n; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        int idx = _mm_cmpestri(set, 2, chunk, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY);
+        if (idx < 16) return i + static_cast<size_t>(idx);
+    }
+    return findScalar(s, i, n, lo, up);
+}
+
+__attribute__((target("sse4.2")))
+static size_t findHighSse42(const unsigned char* s, size_t i, size_t n) {
+    for (; i + 16 <= n; i += 16) {
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i))));
+        if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    return findHighScalar(s, i, n);
+}
+
+__attribute__((target("avx2")))
+static size_t findAvx2(const unsigned char* s, size_t i, size_t n, unsigned char lo, unsigned char up) {
+    const __m256i vlo = _mm256_set1_epi8(static_cast<char>(lo));
+    const __m256i vup = _mm256_set1_epi8(static_cast<char>(up));
+    for (; i + 32 <= n; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, vlo), _mm256_cmpeq_epi8(chunk, vup))));
+        if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    // Previews are short: a 16-byte step before going scalar covers most tails
+    if (i + 16 <= n) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm256_castsi256_si128(vlo)),
+                         _mm_cmpeq_epi8(chunk, _mm256_castsi256_si128(vup)))));
+        if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+        i += 16;
+    }
+    return findScalar(s, i, n, lo, up);
+}
+
+__attribute__((target("avx2")))
+static size_t findHighAvx2(const unsigned char* s, size_t i, size_t n) {
+    for (; i + 32 <= n; i += 32) {
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i))));
+        if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    return findHighSse42(s, i, n);
+}
+#endif
+
+struct Isa {
+    const char* name;
+    FindFn find;
+    FindHighFn findHigh;
+};
+
+static constexpr Isa ISA_SCALAR{"scalar", findScalar, findHighScalar};
+#ifdef HYPRCLIPX_X86
+static constexpr Isa ISA_SSE42{"sse4.2", findSse42, findHighSse42};
+static constexpr Isa ISA_AVX2{"avx2", findAvx2, findHighAvx2};
+#endif
+
+static Isa detectIsa() {
+#ifdef HYPRCLIPX_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return ISA_AVX2;
+    if (__builtin_cpu_supports("sse4.2")) return ISA_SSE42;
+#endif
+    return ISA_SCALAR;
+}
+
+static Isa s_isa = detectIsa();
+
+const char* FuzzyMatcher::isa() {
+    return s_isa.name;
+}
+
+bool FuzzyMatcher::setIsa(std::string_view isa) {
+    if (isa == "scalar") { s_isa = ISA_SCALAR; return true; }
+#ifdef HYPRCLIPX_X86
+    __builtin_cpu_init();
+    if (isa == "sse4.2" && __builtin_cpu_supports("sse4.2")) { s_isa = ISA_SSE42; return true; }
+    if (isa == "avx2" && __builtin_cpu_supports("avx2")) { s_isa = ISA_AVX2; return true; }
+#endif
+    return false;
+}
+
+// ============================================================================
+// Scoring
+// ============================================================================
+
+// Text as the scoring pass sees it: folded characters, classes, byte offsets
+struct ByteText {
+    const unsigned char* s;
+    char32_t fold(size_t i) const { return (s[i] >= 'A' && s[i] <= 'Z') ? s[i] + 32u : s[i]; }
+    // Bytes of multi-byte characters count as letters
+    CharClass cls(size_t i) const { return s[i] < 0x80 ? classOf(s[i]) : Letter; }
+    uint32_t offset(size_t i) const { return static_cast<uint32_t>(i); }
+};
+
+struct CodePointText {
+    const char32_t* cps;
+    const uint32_t* offsets;
+    char32_t fold(size_t i) const { return foldCase(cps[i]); }
+    CharClass cls(size_t i) const { return classOf(cps[i]); }
+    uint32_t offset(size_t i) const { return offsets[i]; }
+};
+
+// [start, end) spans the first in-order occurrence of the pattern, ending at
+// its last character. Narrows the window from the right, then scores it.
+template <typename Text>
+static int scoreWindow(const Text& text, std::u32string_view pattern, size_t start, size_t end,
+                       std::vector<uint32_t>* positions) {
+    size_t j = pattern.size();
+    for (size_t i = end; i-- > start;) {
+        if (text.fold(i) == pattern[j - 1] && --j == 0) {
+            start = i;
+            break;
+        }
+    }
+
+    if (positions) positions->clear();
+    int score = 0, consecutive = 0, firstBonus = 0;
+    bool inGap = false;
+    size_t p = 0;
+    CharClass prev = start > 0 ? text.cls(start - 1) : White;
+    for (size_t i = start; i < end; i++) {
+        CharClass cls = text.cls(i);
+        if (p < pattern.size() && text.fold(i) == pattern[p]) {
+            if (positions) positions->push_back(text.offset(i));
+            score += SCORE_MATCH;
+            int bonus = bonusFor(prev, cls);
+            if (consecutive == 0) {
+                firstBonus = bonus;
+            } else {
+                // A run keeps the bonus of the boundary it started on
+                if (bonus >= BONUS_BOUNDARY && bonus > firstBonus) firstBonus = bonus;
+                bonus = std::max({bonus, firstBonus, BONUS_CONSECUTIVE});
+            }
+            score += p == 0 ? bonus * BONUS_FIRST_CHAR_MULTIPLIER : bonus;
+            inGap = false;
+            consecutive++;
+            p++;
+        } else {
+            score += inGap ? SCORE_GAP_EXTENSION : SCORE_GAP_START;
+            inGap = true;
+            consecutive = 0;
+            firstBonus = 0;
+        }
+        prev = cls;
+    }
+    return score;
+}
+
+// ============================================================================
+// FuzzyMatcher
+// ============================================================================
+
+FuzzyMatcher::FuzzyMatcher(std::string_view pattern) {
+    for (size_t i = 0; i < pattern.size();) {
+        char32_t c = foldCase(decodeUtf8(pattern, i));
+        m_pattern.push_back(c);
+        if (c >= 0x80) m_ascii = false;
+    }
+}
+
+std::optional<int> FuzzyMatcher::match(std::string_view text, std::vector<uint32_t>* positions) const {
+    if (positions) positions->clear();
+    if (m_pattern.empty()) return 0;
+
+    // Forward pass: first in-order occurrence of the pattern. Each ASCII
+    // character is a byte scan for either case (ASCII bytes never occur
+    // inside multi-byte characters); a non-ASCII one skips the ASCII runs
+    // and only decodes from there.
+    const auto* s = reinterpret_cast<const unsigned char*>(text.data());
+    size_t n = text.size();
+    size_t b = 0, start = 0;
+    for (size_t p = 0; p < m_pattern.size();) {
+        char32_t want = m_pattern[p];
+        if (want < 0x80) {
+            auto lo = static_cast<unsigned char>(want);
+            unsigned char up = (lo >= 'a' && lo <= 'z') ? static_cast<unsigned char>(lo - 32) : lo;
+            b = s_isa.find(s, b, n, lo, up);
+        } else {
+            b = s_isa.findHigh(s, b, n);
+        }
+        if (b == n) return std::nullopt;
+        size_t at = b;
+        if (want < 0x80) b++;
+        else if (foldCase(decodeUtf8(text, b)) != want) continue;
+        if (p++ == 0) start = at;
+    }
+    if (m_ascii) return scoreWindow(ByteText{s}, m_pattern, start, b, positions);
+
+    // Decode the window, plus the character before it for the boundary bonus
+    thread_local std::u32string cps;
+    thread_local std::vector<uint32_t> offsets;
+    cps.clear();
+    offsets.clear();
+    size_t from = start;
+    if (from > 0) {
+        from--;
+        while (from > 0 && (s[from] & 0xC0) == 0x80) from--;
+    }
+    for (size_t i = from; i < b;) {
+        offsets.push_back(static_cast<uint32_t>(i));
+        cps.push_back(decodeUtf8(text, i));
+    }
+    return scoreWindow(CodePointText{cps.data(), offsets.data()}, m_pattern, from < start ? 1 : 0,
+                       cps.size(), positions);
+}
+
+} // namespace hyprclipx
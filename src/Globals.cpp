@@ -1,23 +1,25 @@
 // Global instance management (plugin side - NO GTK!)
-// Uses Hyprland internal APIs for window info, fork+exec for UI
+// Uses Hyprland internal APIs for window info, a persistent socket for the UI
 
 #include "hyprclipx/Globals.hpp"
 #include "hyprclipx/IPCHandler.hpp"
 #include "hyprclipx/ConfigParser.hpp"
+#include "hyprclipx/SelectionNotifier.hpp"
+#include "hyprclipx/CaretLocator.hpp"
+#include "hyprclipx/UIChannel.hpp"
+#include "hyprclipx/UIMessage.hpp"
 
 #include <hyprland/src/Compositor.hpp>
 #include <hyprland/src/helpers/Monitor.hpp>
 #include <hyprland/src/desktop/Workspace.hpp>
 #include <hyprland/src/desktop/view/Window.hpp>
 #include <hyprland/src/managers/SeatManager.hpp>
+#include <hyprland/src/managers/input/InputManager.hpp>
+#include <hyprland/src/managers/input/TextInput.hpp>
 
+#include <chrono>
 #include <cstdlib>
-#include <cstdio>
-#include <cstring>
-#include <fstream>
 #include <format>
-#include <unistd.h>
-#include <sys/wait.h>
 
 namespace hyprclipx {
 
@@ -35,9 +37,19 @@ void initGlobals() {
     g_config.userSettingsFile = home + "/.config/hyprclipx/settings.json";
 
     g_ipcHandler = std::make_unique<IPCHandler>();
+
+    // clipman-daemon falls back to polling wl-paste if this is unavailable
+    startSelectionNotifier(g_config.selectionSocket);
+
+    startCaretLocator();
+    startUIChannel(g_config.uiSocket);
 }
 
 void cleanupGlobals() {
+    // Caret results feed the channel: stop them first
+    stopCaretLocator();
+    stopUIChannel();
+    stopSelectionNotifier();
     g_ipcHandler.reset();
 }
 
@@ -46,37 +58,84 @@ void reloadConfig() {
 }
 
 // ============================================================================
-// Toggle helpers (matching ags-toggle-clipboard.template flow EXACTLY)
-// 1. Get caret position via AT-SPI (PRIMARY)
-// 2. Fallback to mouse ONLY if AT-SPI fails
-// 3. Save previous window
-// 4. Toggle UI
+// Toggle helpers (matching ags-toggle-clipboard.template flow)
+// 1. Snapshot the focused window, take its monitor (now, before focus moves)
+// 2. Take the caret from the focused text input if it reports one, else
+//    get it from caret-daemon / AT-SPI (on the worker), mouse position
+//    taken now as fallback
+// 3. Send the command over the UI channel
 // ============================================================================
 
+// Bumped by every hide: a show whose caret lookup was still running when the
+// window was hidden is dropped rather than reopening it
+static uint64_t s_hideEpoch = 0;
+
+// The focused text input's cursor rectangle, in global logical coordinates.
+// Clients using text-input (GTK, Qt, Chromium with its Wayland IME) send it
+// as the caret moves. It is surface-local: placed on the window the way
+// Hyprland places IME popups.
+static std::optional<std::pair<int, int>> textInputCaret(SP<CWLSurfaceResource> focus, PHLWINDOW window) {
+    if (!focus || !window || window->m_isX11) return std::nullopt;
+    auto* textInput = g_pInputManager->m_relay.getFocusedTextInput();
+    if (!textInput || textInput->focusedSurface() != focus || !textInput->hasCursorRectangle())
+        return std::nullopt;
+    CBox box = textInput->cursorBox();
+    Vector2D origin = window->m_realPosition->goal();
+    return std::pair{static_cast<int>(origin.x + box.x), static_cast<int>(origin.y + box.y)};
+}
+
+// Window strings are only matched against, never shown: keep the command
+// line short, cutting on a UTF-8 character boundary
+static std::string capped(const std::string& s) {
+    static constexpr size_t MAX_BYTES = 256;
+    if (s.size() <= MAX_BYTES) return s;
+    size_t end = MAX_BYTES;
+    while (end > 0 && (static_cast<unsigned char>(s[end]) & 0xC0) == 0x80) end--;
+    return s.substr(0, end);
+}
+
 void captureAndSendUI(const std::string& cmd) {
-    // Reap zombie children from previous calls
-    while (waitpid(-1, nullptr, WNOHANG) > 0) {}
+    // Hotkey time for the UI's hotkey → first frame latency (steady_clock is
+    // CLOCK_MONOTONIC, the clock of g_get_monotonic_time)
+    auto since = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
 
     // Get the keyboard-focused window via SeatManager (not mouse cursor!)
     // This correctly identifies the focused window on multi-monitor setups
     // regardless of where the mouse pointer is
     PHLWINDOW pFocusedWindow;
-    {
-        auto focusSurface = g_pSeatManager->m_state.keyboardFocus.lock();
-        if (focusSurface)
-            pFocusedWindow = g_pCompositor->getWindowFromSurface(focusSurface);
-    }
+    auto focusSurface = g_pSeatManager->m_state.keyboardFocus.lock();
+    if (focusSurface)
+        pFocusedWindow = g_pCompositor->getWindowFromSurface(focusSurface);
+
+    UIMessage msg;
+    msg.cmd = cmd;
+    msg.since = since;
 
-    // Save previous window address BEFORE opening UI (must capture now,
+    // Snapshot the paste target BEFORE opening UI (must capture now,
     // because focus changes once clipboard window opens)
     if (pFocusedWindow) {
-        std::string windowAddr = std::format("0x{:x}", (uintptr_t)pFocusedWindow.get());
-        std::ofstream f(g_config.prevWindowFile);
-        if (f.is_open()) f << windowAddr;
+        UIWindow& w = msg.window;
+        w.address = std::format("0x{:x}", (uintptr_t)pFocusedWindow.get());
+        w.windowClass = capped(pFocusedWindow->m_class);
+        w.initialClass = capped(pFocusedWindow->m_initialClass);
+        w.title = capped(pFocusedWindow->m_title);
+        w.initialTitle = capped(pFocusedWindow->m_initialTitle);
+        w.pid = static_cast<int>(pFocusedWindow->getPID());
+        w.xwayland = pFocusedWindow->m_isX11;
+        msg.hasWindow = true;
     }
 
+    // Everything the lookup needs comes from compositor state, now: the
+    // mouse position is in logical coordinates like the monitor's
+    Vector2D mouse = g_pInputManager->getMouseCoordsInternal();
+    CaretLookup lookup{g_config.caretSocket, g_config.caretHelper,
+                       pFocusedWindow ? static_cast<int>(pFocusedWindow->getPID()) : 0,
+                       0, 0, 1920, 1080,
+                       textInputCaret(focusSurface, pFocusedWindow),
+                       std::pair{static_cast<int>(mouse.x), static_cast<int>(mouse.y)}};
+
     // Capture monitor bounds from the focused window's monitor
-    int monX = 0, monY = 0, monW = 1920, monH = 1080;
     {
         PHLMONITOR monitor;
         if (pFocusedWindow)
@@ -84,96 +143,33 @@ void captureAndSendUI(const std::string& cmd) {
         if (!monitor)
             monitor = g_pCompositor->getMonitorFromCursor();
         if (monitor) {
-            monX = static_cast<int>(monitor->m_position.x);
-            monY = static_cast<int>(monitor->m_position.y);
-            monW = static_cast<int>(monitor->m_size.x);
-            monH = static_cast<int>(monitor->m_size.y);
+            lookup.monX = msg.monX = static_cast<int>(monitor->m_position.x);
+            lookup.monY = msg.monY = static_cast<int>(monitor->m_position.y);
+            lookup.monW = msg.monW = static_cast<int>(monitor->m_size.x);
+            lookup.monH = msg.monH = static_cast<int>(monitor->m_size.y);
+            msg.hasMonitor = true;
         }
     }
 
-    // Fork child: capture CARET position + exec UI
-    // All blocking calls happen in child (never blocks compositor!)
-    std::string caretHelper = g_config.caretHelper;
-    std::string caretPosFile = g_config.caretPosFile;
-    std::string uiArg = "--" + cmd;
-
-    if (fork() == 0) {
-        setsid();  // Detach from compositor process group
-
-        // Format: caretX,caretY,monX,monY,monW,monH
-        auto writeCaretFile = [&](int cx, int cy) {
-            std::ofstream f(caretPosFile);
-            if (f.is_open())
-                f << cx << "," << cy << "," << monX << "," << monY << "," << monW << "," << monH;
-        };
-
-        // Get cursor position via hyprctl (always in Hyprland logical coordinates)
-        auto getCursorPos = [](int& outX, int& outY) -> bool {
-            FILE* p = popen("hyprctl cursorpos -j 2>/dev/null", "r");
-            if (!p) return false;
-            char buf[256] = {};
-            std::string result;
-            while (fgets(buf, sizeof(buf), p)) result += buf;
-            pclose(p);
-            size_t xp = result.find("\"x\":");
-            size_t yp = result.find("\"y\":");
-            if (xp != std::string::npos) outX = std::atoi(result.c_str() + xp + 4);
-            if (yp != std::string::npos) outY = std::atoi(result.c_str() + yp + 4);
-            return outX >= 0 && outY >= 0;
-        };
-
-        // 1. AT-SPI caret capture (PRIMARY - matching AGS get-caret-position.py)
-        bool caretFound = false;
-        FILE* pipe = popen(("/usr/bin/python3 " + caretHelper + " 2>/dev/null").c_str(), "r");
-        if (pipe) {
-            char buf[256] = {};
-            std::string result;
-            while (fgets(buf, sizeof(buf), pipe)) result += buf;
-            int rc = pclose(pipe);
-            if (rc == 0 && !result.empty()) {
-                // Parse {"x": 123, "y": 456}
-                int cx = -1, cy = -1;
-                size_t xp = result.find("\"x\":");
-                size_t yp = result.find("\"y\":");
-                if (xp != std::string::npos) cx = std::atoi(result.c_str() + xp + 4);
-                if (yp != std::string::npos) cy = std::atoi(result.c_str() + yp + 4);
-                if (cx >= 0 && cy >= 0) {
-                    // Clamp AT-SPI position to monitor bounds
-                    // AT-SPI can return coordinates slightly outside (physical
-                    // vs logical pixels on multi-monitor setups with scaling)
-                    cx = std::max(cx, monX);
-                    cx = std::min(cx, monX + monW - 1);
-                    cy = std::max(cy, monY);
-                    cy = std::min(cy, monY + monH - 1);
-                    writeCaretFile(cx, cy);
-                    caretFound = true;
-                }
+    // The blocking lookups run on the caret worker, never in the compositor.
+    // A known caret goes through it too, to stay in order with them.
+    locateCaret(std::move(lookup),
+        [msg = std::move(msg), epoch = s_hideEpoch](std::optional<std::pair<int, int>> caret) mutable {
+            if (epoch != s_hideEpoch) return;
+            if (caret) {
+                msg.hasCaret = true;
+                msg.caretX = caret->first;
+                msg.caretY = caret->second;
             }
-        }
-
-        // 2. Fallback to cursor position if AT-SPI failed or returned out-of-bounds
-        if (!caretFound) {
-            int mx = -1, my = -1;
-            if (getCursorPos(mx, my)) {
-                writeCaretFile(mx, my);
-            }
-        }
-
-        // Exec UI binary (replaces this child process)
-        execlp("hyprclipx-ui", "hyprclipx-ui", uiArg.c_str(), nullptr);
-        _exit(1);
-    }
+            sendToUI(encodeUIMessage(msg));
+        });
 }
 
 void sendUICommand(const std::string& cmd) {
-    while (waitpid(-1, nullptr, WNOHANG) > 0) {}
-
-    if (fork() == 0) {
-        setsid();
-        std::string arg = "--" + cmd;
-        execlp("hyprclipx-ui", "hyprclipx-ui", arg.c_str(), nullptr);
-        _exit(1);
-    }
+    if (cmd == "hide") s_hideEpoch++;
+    UIMessage msg;
+    msg.cmd = cmd;
+    sendToUI(encodeUIMessage(msg));
 }
 
 } // namespace hyprclipx
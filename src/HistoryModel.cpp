@@ -0,0 +1,97 @@
+// Local clipboard history mirror (see HistoryModel.hpp)
+
+#include "hyprclipx/HistoryModel.hpp"
+#include "hyprclipx/FuzzyMatcher.hpp"
+#include <algorithm>
+
+namespace hyprclipx {
+
+void applyChanges(std::vector<ClipboardEntry>& items, const std::vector<HistoryChange>& changes) {
+    for (const auto& change : changes) {
+        auto it = std::find_if(items.begin(), items.end(),
+            [&](const ClipboardEntry& e) { return e.uuid == change.item.uuid; });
+        switch (change.op) {
+            case HistoryChange::Op::Insert:
+            case HistoryChange::Op::Update:
+                // Both land on top; an update replaces the old position
+                if (it != items.end()) items.erase(it);
+                items.insert(items.begin(), change.item);
+                break;
+            case HistoryChange::Op::Delete:
+                if (it != items.end()) items.erase(it);
+                break;
+            case HistoryChange::Op::Favorite:
+                if (it != items.end()) it->favorite = change.item.favorite;
+                break;
+        }
+    }
+}
+
+void HistoryModel::reset(std::shared_ptr<const EntryStore> store, uint64_t generation) {
+    m_store = std::move(store);
+    m_generation = generation;
+    m_synced = true;
+}
+
+void HistoryModel::apply(const std::vector<HistoryChange>& changes, uint64_t generation) {
+    m_synced = true;  // caught up to `generation` either way
+    if (generation <= m_generation) return;
+
+    m_store = m_store->withChanges(changes);
+    m_generation = generation;
+}
+
+std::vector<ClipboardEntry> HistoryModel::query(std::string_view filter, std::string_view search,
+                                                int limit, int offset, bool* more) const {
+    const EntryStore& store = *m_store;
+    bool favorites = filter == "favorites";
+    bool typed = filter == "text" || filter == "image";
+    EntryType wanted = filter == "image" ? EntryType::Image : EntryType::Text;
+    auto accepts = [&](size_t row) {
+        return !(favorites && !store.favorite(row)) && !(typed && store.type(row) != wanted);
+    };
+
+    std::vector<ClipboardEntry> out;
+    if (more) *more = false;
+
+    if (search.empty()) {
+        for (size_t row = 0; row < store.size(); row++) {
+            if (!accepts(row)) continue;
+            if (offset > 0) { offset--; continue; }
+            if (static_cast<int>(out.size()) >= limit) {
+                if (more) *more = true;
+                break;
+            }
+            out.push_back(store.entry(row));
+        }
+        return out;
+    }
+
+    // Score everything, order only the pages asked for
+    struct Hit {
+        int score;
+        uint32_t row;
+    };
+    FuzzyMatcher matcher(search);
+    std::vector<Hit> hits;
+    for (size_t row = 0; row < store.size(); row++) {
+        if (!accepts(row)) continue;
+        if (auto score = matcher.match(store.preview(row)))
+            hits.push_back({*score, static_cast<uint32_t>(row)});
+    }
+
+    size_t first = std::min(hits.size(), static_cast<size_t>(std::max(offset, 0)));
+    size_t last = std::min(hits.size(), first + static_cast<size_t>(std::max(limit, 0)));
+    if (more) *more = last < hits.size();
+    std::partial_sort(hits.begin(), hits.begin() + static_cast<ptrdiff_t>(last), hits.end(),
+        [](const Hit& a, const Hit& b) { return a.score != b.score ? a.score > b.score : a.row < b.row; });
+
+    for (size_t i = first; i < last; i++) {
+        ClipboardEntry entry = store.entry(hits[i].row);
+        matcher.match(entry.preview, &entry.highlight);
+        out.push_back(std::move(entry));
+    }
+    return out;
+}
+
+} // namespace hyprclipx
@@ -1,5 +1,5 @@
 // IPC command handling (plugin side - NO GTK!)
-// Forwards UI commands to hyprclipx-ui via fork+exec
+// Forwards UI commands to hyprclipx-ui over the UI channel
 
 #include "hyprclipx/IPCHandler.hpp"
 #include "hyprclipx/Globals.hpp"
@@ -0,0 +1,553 @@
+// Single-pass JSON reader for clipman-daemon replies
+// No substr, no per-key rescans: one cursor walks the reply front to back
+
+#include "hyprclipx/JsonParser.hpp"
+#include <cstring>
+
+namespace hyprclipx {
+
+namespace {
+
+// ============================================================================
+// Cursor over the input
+// ============================================================================
+
+struct Reader {
+    const char* p;
+    const char* end;
+
+    explicit Reader(std::string_view s) : p(s.data()), end(s.data() + s.size()) {}
+
+    bool atEnd() const { return p >= end; }
+
+    void skipWs() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+    }
+
+    bool consume(char c) {
+        skipWs();
+        if (p < end && *p == c) { p++; return true; }
+        return false;
+    }
+
+    char peek() {
+        skipWs();
+        return p < end ? *p : '\0';
+    }
+};
+
+void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xc0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3f));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xe0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (cp & 0x3f));
+    } else {
+        out += static_cast<char>(0xf0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3f));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (cp & 0x3f));
+    }
+}
+
+bool readHex4(const char*& p, const char* end, uint32_t& out) {
+    if (end - p < 4) return false;
+    out = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = *p++;
+        out <<= 4;
+        if (c >= '0' && c <= '9')      out |= static_cast<uint32_t>(c - '0');
+        else if (c >= 'a' && c <= 'f') out |= static_cast<uint32_t>(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') out |= static_cast<uint32_t>(c - 'A' + 10);
+        else return false;
+    }
+    return true;
+}
+
+// Reads a string literal (cursor on the opening quote). `raw` is the body
+// between the quotes; `escaped` tells whether it still needs decoding.
+bool readRawString(Reader& r, std::string_view& raw, bool& escaped) {
+    if (!r.consume('"')) return false;
+    const char* start = r.p;
+    escaped = false;
+    while (r.p < r.end) {
+        // memchr is vectorized; jump straight to the next quote
+        const char* q = static_cast<const char*>(
+            std::memchr(r.p, '"', static_cast<size_t>(r.end - r.p)));
+        if (!q) return false;
+
+        // A quote preceded by an odd number of backslashes is escaped
+        size_t slashes = 0;
+        for (const char* b = q; b > start && b[-1] == '\\'; b--) slashes++;
+        if (slashes) escaped = true;
+        if (slashes % 2 == 0) {
+            if (!escaped && std::memchr(start, '\\', static_cast<size_t>(q - start)))
+                escaped = true;
+            raw = std::string_view(start, static_cast<size_t>(q - start));
+            r.p = q + 1;
+            return true;
+        }
+        r.p = q + 1;
+    }
+    return false;
+}
+
+bool readString(Reader& r, std::string& out) {
+    std::string_view raw;
+    bool escaped = false;
+    if (!readRawString(r, raw, escaped)) return false;
+    if (!escaped) {
+        out.assign(raw);
+        return true;
+    }
+    out.clear();
+    return unescapeJsonString(raw, out);
+}
+
+// Bare token (number, true, false, null) as a view
+std::string_view readLiteral(Reader& r) {
+    r.skipWs();
+    const char* start = r.p;
+    while (r.p < r.end && *r.p != ',' && *r.p != '}' && *r.p != ']' &&
+           *r.p != ' ' && *r.p != '\t' && *r.p != '\n' && *r.p != '\r')
+        r.p++;
+    return std::string_view(start, static_cast<size_t>(r.p - start));
+}
+
+// Skips any value, nested containers included, without decoding it
+bool skipValue(Reader& r) {
+    char c = r.peek();
+    if (c == '"') {
+        std::string_view raw;
+        bool escaped;
+        return readRawString(r, raw, escaped);
+    }
+    if (c != '{' && c != '[') return !readLiteral(r).empty();
+
+    int depth = 0;
+    while (r.p < r.end) {
+        char ch = *r.p;
+        if (ch == '"') {
+            std::string_view raw;
+            bool escaped;
+            if (!readRawString(r, raw, escaped)) return false;
+            continue;
+        }
+        r.p++;
+        if (ch == '{' || ch == '[') depth++;
+        else if ((ch == '}' || ch == ']') && --depth == 0) return true;
+    }
+    return false;
+}
+
+bool readKey(Reader& r, std::string_view& key, std::string& scratch) {
+    bool escaped = false;
+    if (!readRawString(r, key, escaped)) return false;
+    if (escaped) {
+        scratch.clear();
+        if (!unescapeJsonString(key, scratch)) return false;
+        key = scratch;
+    }
+    return r.consume(':');
+}
+
+bool isTruthy(std::string_view v) {
+    return v == "true" || v == "1" || v == "True";
+}
+
+// Unsigned integer literal; anything else reads as 0
+uint64_t readUnsigned(Reader& r) {
+    std::string_view v = readLiteral(r);
+    uint64_t n = 0;
+    for (char c : v) {
+        if (c < '0' || c > '9') return 0;
+        n = n * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return n;
+}
+
+// ============================================================================
+// Entry object → ClipboardEntry, every field filled in the same pass
+// ============================================================================
+
+bool readEntry(Reader& r, ClipboardEntry& e) {
+    if (!r.consume('{')) return false;
+
+    bool haveType = false, haveFavorite = false, haveSize = false;
+    uint64_t byteSize = 0;
+    std::string keyScratch;
+    std::string scalar;
+
+    if (r.consume('}')) return true;
+    do {
+        std::string_view key;
+        if (!readKey(r, key, keyScratch)) return false;
+
+        // Nulls (e.g. thumb on text items) leave the field empty
+        if (r.peek() == 'n') { readLiteral(r); continue; }
+
+        bool ok = true;
+        if (key == "uuid") {
+            ok = readString(r, e.uuid);
+        } else if (key == "type") {
+            ok = readString(r, e.type);
+            haveType = true;
+        } else if (key == "content_type") {
+            ok = haveType ? skipValue(r) : readString(r, e.type);
+        } else if (key == "preview") {
+            ok = readString(r, e.preview);
+        } else if (key == "thumb") {
+            ok = readString(r, e.thumb);
+        } else if (key == "created_at") {
+            ok = readString(r, e.createdAt);
+        } else if (key == "byte_size") {
+            byteSize = readUnsigned(r);
+            haveSize = true;
+        } else if (key == "favorite" || key == "is_favorite") {
+            bool primary = key == "favorite";
+            if (!primary && haveFavorite) {
+                ok = skipValue(r);
+            } else {
+                if (r.peek() == '"') {
+                    ok = readString(r, scalar);
+                    e.favorite = isTruthy(scalar);
+                } else {
+                    e.favorite = isTruthy(readLiteral(r));
+                }
+                haveFavorite = primary;
+            }
+        } else {
+            ok = skipValue(r);
+        }
+        if (!ok) return false;
+    } while (r.consume(','));
+
+    // Images are searched by their preview; text is cut at preview_length
+    // (whitespace folded to spaces keeps the byte count)
+    e.fullPreview = e.type == "image" || (haveSize && byteSize == e.preview.size());
+    return r.consume('}');
+}
+
+// Signed integer literal (coordinates); anything else reads as 0
+int64_t readSigned(Reader& r) {
+    r.skipWs();
+    bool negative = r.p < r.end && *r.p == '-';
+    if (negative) r.p++;
+    auto n = static_cast<int64_t>(readUnsigned(r));
+    return negative ? -n : n;
+}
+
+// [a, b, ...] of integers into `out` (exactly `count` of them)
+bool readIntArray(Reader& r, int* out, int count) {
+    if (!r.consume('[')) return false;
+    for (int i = 0; i < count; i++) {
+        if (i && !r.consume(',')) return false;
+        out[i] = static_cast<int>(readSigned(r));
+    }
+    return r.consume(']');
+}
+
+// {"address": "0x…", "class": …} (hyprctl activewindow's keys)
+bool readWindow(Reader& r, UIWindow& w) {
+    std::string keyScratch;
+    if (!r.consume('{')) return false;
+    if (r.consume('}')) return true;
+    do {
+        std::string_view key;
+        if (!readKey(r, key, keyScratch)) return false;
+        bool ok = true;
+        if (key == "address" && r.peek() == '"') ok = readString(r, w.address);
+        else if (key == "class" && r.peek() == '"') ok = readString(r, w.windowClass);
+        else if (key == "initialClass" && r.peek() == '"') ok = readString(r, w.initialClass);
+        else if (key == "title" && r.peek() == '"') ok = readString(r, w.title);
+        else if (key == "initialTitle" && r.peek() == '"') ok = readString(r, w.initialTitle);
+        else if (key == "pid") w.pid = static_cast<int>(readSigned(r));
+        else if (key == "xwayland") w.xwayland = readLiteral(r) == "true";
+        else ok = skipValue(r);
+        if (!ok) return false;
+    } while (r.consume(','));
+    return r.consume('}');
+}
+
+bool readEnvelopeField(Reader& r, std::string_view key, ReplyEnvelope& env) {
+    if (key == "id") {
+        env.id = readUnsigned(r);
+        return true;
+    }
+    if (key == "generation") {
+        env.generation = readUnsigned(r);
+        return true;
+    }
+    if (key == "event" && r.peek() == '"') {
+        return readString(r, env.event);
+    }
+    if (key == "status") {
+        std::string status;
+        if (r.peek() != '"') return skipValue(r);
+        if (!readString(r, status)) return false;
+        env.ok = status == "ok";
+        return true;
+    }
+    if (key == "more") {
+        env.more = readLiteral(r) == "true";
+        return true;
+    }
+    if (key == "resync") {
+        env.resync = readLiteral(r) == "true";
+        return true;
+    }
+    if (key == "error" && r.peek() == '"') {
+        return readString(r, env.error);
+    }
+    if (key == "next_cursor" && r.peek() == '"') {
+        return readString(r, env.nextCursor);
+    }
+    return skipValue(r);
+}
+
+// ============================================================================
+// Change object → HistoryChange ({"op": ..., "item": {...}} or "uuid")
+// ============================================================================
+
+bool readChange(Reader& r, HistoryChange& c, bool& known) {
+    if (!r.consume('{')) return false;
+    known = false;
+
+    std::string keyScratch;
+    std::string scalar;
+
+    if (r.consume('}')) return true;
+    do {
+        std::string_view key;
+        if (!readKey(r, key, keyScratch)) return false;
+        if (r.peek() == 'n') { readLiteral(r); continue; }
+
+        bool ok = true;
+        if (key == "op") {
+            ok = readString(r, scalar);
+            known = true;
+            if (scalar == "insert")        c.op = HistoryChange::Op::Insert;
+            else if (scalar == "update")   c.op = HistoryChange::Op::Update;
+            else if (scalar == "delete")   c.op = HistoryChange::Op::Delete;
+            else if (scalar == "favorite") c.op = HistoryChange::Op::Favorite;
+            else known = false;
+        } else if (key == "item") {
+            ok = readEntry(r, c.item);
+        } else if (key == "uuid") {
+            ok = readString(r, c.item.uuid);
+        } else if (key == "favorite") {
+            c.item.favorite = isTruthy(readLiteral(r));
+        } else {
+            ok = skipValue(r);
+        }
+        if (!ok) return false;
+    } while (r.consume(','));
+
+    return r.consume('}');
+}
+
+} // namespace
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool unescapeJsonString(std::string_view raw, std::string& out) {
+    out.reserve(out.size() + raw.size());
+    const char* p = raw.data();
+    const char* end = p + raw.size();
+
+    while (p < end) {
+        const char* bs = static_cast<const char*>(
+            std::memchr(p, '\\', static_cast<size_t>(end - p)));
+        if (!bs) {
+            out.append(p, static_cast<size_t>(end - p));
+            break;
+        }
+        out.append(p, static_cast<size_t>(bs - p));
+        p = bs + 1;
+        if (p >= end) return false;
+
+        char c = *p++;
+        switch (c) {
+            case '"':  out += '"';  break;
+            case '\\': out += '\\'; break;
+            case '/':  out += '/';  break;
+            case 'b':  out += '\b'; break;
+            case 'f':  out += '\f'; break;
+            case 'n':  out += '\n'; break;
+            case 'r':  out += '\r'; break;
+            case 't':  out += '\t'; break;
+            case 'u': {
+                uint32_t cp;
+                if (!readHex4(p, end, cp)) return false;
+                if (cp >= 0xd800 && cp <= 0xdbff) {
+                    // High surrogate: combine with the following \uDC00..\uDFFF
+                    uint32_t lo;
+                    const char* save = p;
+                    if (end - p >= 6 && p[0] == '\\' && p[1] == 'u' &&
+                        (p += 2, readHex4(p, end, lo)) && lo >= 0xdc00 && lo <= 0xdfff) {
+                        cp = 0x10000 + ((cp - 0xd800) << 10) + (lo - 0xdc00);
+                    } else {
+                        p = save;
+                        cp = 0xfffd;  // unpaired surrogate
+                    }
+                } else if (cp >= 0xdc00 && cp <= 0xdfff) {
+                    cp = 0xfffd;      // stray low surrogate
+                }
+                appendUtf8(out, cp);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+std::string escapeJsonString(std::string_view in) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    std::string out;
+    out.reserve(in.size() + 8);
+    for (char c : in) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n";  break;
+            case '\r': out += "\\r";  break;
+            case '\t': out += "\\t";  break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += "\\u00";
+                    out += HEX[(c >> 4) & 0xf];
+                    out += HEX[c & 0xf];
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out;
+}
+
+bool parseUIMessage(std::string_view json, UIMessage& out) {
+    Reader r(json);
+    std::string keyScratch;
+    if (!r.consume('{')) return false;
+    if (!r.consume('}')) {
+        do {
+            std::string_view key;
+            if (!readKey(r, key, keyScratch)) return false;
+            bool ok = true;
+            if (key == "cmd" && r.peek() == '"') {
+                ok = readString(r, out.cmd);
+            } else if (key == "since") {
+                out.since = readSigned(r);
+            } else if (key == "caret") {
+                int v[2] = {};
+                ok = out.hasCaret = readIntArray(r, v, 2);
+                out.caretX = v[0];
+                out.caretY = v[1];
+            } else if (key == "monitor") {
+                int v[4] = {};
+                ok = out.hasMonitor = readIntArray(r, v, 4);
+                out.monX = v[0];
+                out.monY = v[1];
+                out.monW = v[2];
+                out.monH = v[3];
+            } else if (key == "window") {
+                ok = out.hasWindow = readWindow(r, out.window);
+            } else {
+                ok = skipValue(r);
+            }
+            if (!ok) return false;
+        } while (r.consume(','));
+        if (!r.consume('}')) return false;
+    }
+    return !out.cmd.empty();
+}
+
+bool parseReplyEnvelope(std::string_view json, ReplyEnvelope& env) {
+    Reader r(json);
+    std::string keyScratch;
+    if (!r.consume('{')) return false;
+    if (r.consume('}')) return true;
+    do {
+        std::string_view key;
+        if (!readKey(r, key, keyScratch)) return false;
+        if (key == "data" || key == "changes")
+            return true;  // payload follows, envelope complete
+        if (!readEnvelopeField(r, key, env)) return false;
+    } while (r.consume(','));
+    return r.consume('}');
+}
+
+bool parseListReply(std::string_view json, std::vector<ClipboardEntry>& out,
+                    ReplyEnvelope* env) {
+    Reader r(json);
+    ReplyEnvelope local;
+    ReplyEnvelope& e = env ? *env : local;
+    std::string keyScratch;
+
+    if (!r.consume('{')) return false;
+    if (r.consume('}')) return true;
+    do {
+        std::string_view key;
+        if (!readKey(r, key, keyScratch)) return false;
+
+        if (key != "data") {
+            if (!readEnvelopeField(r, key, e)) return false;
+            continue;
+        }
+
+        if (r.peek() == 'n') { readLiteral(r); continue; }
+        if (!r.consume('[')) return false;
+        if (r.consume(']')) continue;
+        do {
+            ClipboardEntry entry;
+            if (!readEntry(r, entry)) return false;
+            if (!entry.uuid.empty()) out.push_back(std::move(entry));
+        } while (r.consume(','));
+        if (!r.consume(']')) return false;
+    } while (r.consume(','));
+
+    return r.consume('}');
+}
+
+bool parseChangeList(std::string_view json, std::vector<HistoryChange>& out,
+                     ReplyEnvelope* env) {
+    Reader r(json);
+    ReplyEnvelope local;
+    ReplyEnvelope& e = env ? *env : local;
+    std::string keyScratch;
+
+    if (!r.consume('{')) return false;
+    if (r.consume('}')) return true;
+    do {
+        std::string_view key;
+        if (!readKey(r, key, keyScratch)) return false;
+
+        if (key != "changes") {
+            if (!readEnvelopeField(r, key, e)) return false;
+            continue;
+        }
+
+        if (r.peek() == 'n') { readLiteral(r); continue; }
+        if (!r.consume('[')) return false;
+        if (r.consume(']')) continue;
+        do {
+            HistoryChange change;
+            bool known = false;
+            if (!readChange(r, change, known)) return false;
+            if (known && !change.item.uuid.empty()) out.push_back(std::move(change));
+        } while (r.consume(','));
+        if (!r.consume(']')) return false;
+    } while (r.consume(','));
+
+    return r.consume('}');
+}
+
+} // namespace hyprclipx
@@ -0,0 +1,36 @@
+// Rolling latency samples (see LatencyStats.hpp)
+
+#include "hyprclipx/LatencyStats.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace hyprclipx {
+
+void LatencyStats::record(int64_t us) {
+    m_samples[m_next] = us;
+    m_next = (m_next + 1) % WINDOW;
+    m_count++;
+    m_last = us;
+    m_max = std::max(m_max, us);
+}
+
+int64_t LatencyStats::percentile(double p) const {
+    size_t n = std::min<uint64_t>(m_count, WINDOW);
+    if (n == 0) return 0;
+    std::vector<int64_t> sorted(m_samples.begin(), m_samples.begin() + n);
+    size_t rank = static_cast<size_t>(p / 100.0 * static_cast<double>(n - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
+
+std::string LatencyStats::toJson() const {
+    char buf[160];
+    snprintf(buf, sizeof(buf),
+             "{\"count\":%llu,\"last_ms\":%.1f,\"p50_ms\":%.1f,\"p95_ms\":%.1f,\"max_ms\":%.1f}",
+             static_cast<unsigned long long>(m_count), m_last / 1000.0,
+             percentile(50) / 1000.0, percentile(95) / 1000.0, m_max / 1000.0);
+    return buf;
+}
+
+} // namespace hyprclipx
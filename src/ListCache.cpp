@@ -0,0 +1,49 @@
+// Generation-validated list cache (see ListCache.hpp)
+
+#include "hyprclipx/ListCache.hpp"
+#include <algorithm>
+
+namespace hyprclipx {
+
+const ListPage* ListCache::lookup(const Key& key, uint64_t generation) {
+    auto it = std::find_if(m_slots.begin(), m_slots.end(),
+                           [&](const Slot& s) { return s.key == key; });
+    if (it == m_slots.end() || generation == 0 || it->page.generation != generation) {
+        // Generations only grow: an older result can never become valid again
+        if (it != m_slots.end() && generation != 0 && it->page.generation < generation)
+            m_slots.erase(it);
+        m_misses++;
+        return nullptr;
+    }
+    it->lastUsed = ++m_tick;
+    m_hits++;
+    return &it->page;
+}
+
+void ListCache::store(Key key, ListPage page) {
+    uint64_t generation = page.generation;
+    if (generation == 0) return;
+
+    // A newer generation may already be cached; this result is stale then
+    bool newerSeen = std::any_of(m_slots.begin(), m_slots.end(),
+                                 [&](const Slot& s) { return s.page.generation > generation; });
+    if (newerSeen) return;
+
+    // Anything read before this generation is stale by definition
+    std::erase_if(m_slots, [&](const Slot& s) {
+        return s.page.generation < generation || s.key == key;
+    });
+
+    if (m_slots.size() >= MAX_SLOTS) {
+        auto lru = std::min_element(m_slots.begin(), m_slots.end(),
+            [](const Slot& a, const Slot& b) { return a.lastUsed < b.lastUsed; });
+        m_slots.erase(lru);
+    }
+    m_slots.push_back({std::move(key), ++m_tick, std::move(page)});
+}
+
+void ListCache::clear() {
+    m_slots.clear();
+}
+
+} // namespace hyprclipx
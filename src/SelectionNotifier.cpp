@@ -0,0 +1,118 @@
+// Selection change notifications (see SelectionNotifier.hpp)
+// Plugin side - NO GTK, NO threads: everything runs on Hyprland's event loop
+
+#include "hyprclipx/SelectionNotifier.hpp"
+
+#include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/managers/SeatManager.hpp>
+#include <hyprland/src/protocols/types/DataDevice.hpp>
+
+#include <cstring>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace hyprclipx {
+
+static int s_listenFd = -1;
+static std::string s_socketPath;
+static wl_event_source* s_acceptSource = nullptr;
+static CHyprSignalListener s_selectionListener;
+static std::vector<int> s_clients;
+
+// ============================================================================
+// Event encoding
+// ============================================================================
+
+static std::string selectionEvent() {
+    std::vector<std::string> mimes;
+    if (auto source = g_pSeatManager->m_selection.currentSelection.lock())
+        mimes = source->mimes();
+
+    std::string line = "{\"event\":\"selection\",\"mime_types\":[";
+    for (size_t i = 0; i < mimes.size(); i++) {
+        if (i) line += ',';
+        line += '"';
+        for (char c : mimes[i]) {
+            // MIME types are plain tokens; drop anything that would need escaping
+            if (c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20) continue;
+            line += c;
+        }
+        line += '"';
+    }
+    return line + "]}\n";
+}
+
+// Never blocks the compositor: a client that can't take the whole line right
+// now is dropped (it reconnects and gets the current selection)
+static bool sendLine(int fd, const std::string& line) {
+    ssize_t n = send(fd, line.data(), line.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+    return n == static_cast<ssize_t>(line.size());
+}
+
+static void publishSelection() {
+    if (s_clients.empty()) return;
+    std::string line = selectionEvent();
+    std::erase_if(s_clients, [&](int fd) {
+        if (sendLine(fd, line)) return false;
+        close(fd);
+        return true;
+    });
+}
+
+// ============================================================================
+// Socket
+// ============================================================================
+
+static int onAccept(int fd, uint32_t, void*) {
+    int client;
+    while ((client = accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+        if (sendLine(client, selectionEvent())) s_clients.push_back(client);
+        else close(client);
+    }
+    return 0;
+}
+
+bool startSelectionNotifier(const std::string& socketPath) {
+    stopSelectionNotifier();
+
+    // CLOEXEC: spawned processes (the UI, caret helpers) must not inherit these
+    s_listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (s_listenFd == -1) return false;
+
+    struct sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    unlink(socketPath.c_str());
+    if (bind(s_listenFd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == -1 ||
+        listen(s_listenFd, 4) == -1) {
+        close(s_listenFd);
+        s_listenFd = -1;
+        return false;
+    }
+    s_socketPath = socketPath;
+
+    s_acceptSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, s_listenFd,
+                                          WL_EVENT_READABLE, onAccept, nullptr);
+    s_selectionListener = g_pSeatManager->m_events.setSelection.listen([] { publishSelection(); });
+    return true;
+}
+
+void stopSelectionNotifier() {
+    s_selectionListener.reset();
+    if (s_acceptSource) {
+        wl_event_source_remove(s_acceptSource);
+        s_acceptSource = nullptr;
+    }
+    for (int fd : s_clients) close(fd);
+    s_clients.clear();
+    if (s_listenFd != -1) {
+        close(s_listenFd);
+        s_listenFd = -1;
+        unlink(s_socketPath.c_str());
+    }
+}
+
+} // namespace hyprclipx
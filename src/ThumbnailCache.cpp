@@ -0,0 +1,126 @@
+// Thumbnail decode pool and texture LRU (see ThumbnailCache.hpp)
+
+#include "hyprclipx/ThumbnailCache.hpp"
+#include <memory>
+#include <utility>
+
+namespace hyprclipx {
+
+// Uuid a picture currently wants, as object data
+static constexpr const char* WANTED_KEY = "hyprclipx-thumb-uuid";
+
+static bool wants(GtkPicture* picture, const std::string& uuid) {
+    const auto* wanted = static_cast<const char*>(g_object_get_data(G_OBJECT(picture), WANTED_KEY));
+    return wanted && uuid == wanted;
+}
+
+struct DecodeJob {
+    std::string uuid;
+    std::string path;
+    std::shared_ptr<bool> alive;  // the cache's; false once it is destroyed
+};
+
+struct DecodeResult {
+    ThumbnailCache* cache;
+    std::shared_ptr<bool> alive;
+    std::string uuid;
+    GdkTexture* texture;  // owned until handed to finish()
+
+    ~DecodeResult() {
+        if (texture) g_object_unref(texture);
+    }
+};
+
+ThumbnailCache::ThumbnailCache(size_t maxBytes)
+    : m_alive(std::make_shared<bool>(true)), m_maxBytes(maxBytes) {
+    m_pool = g_thread_pool_new(&ThumbnailCache::decode, this, DECODE_THREADS, FALSE, nullptr);
+}
+
+ThumbnailCache::~ThumbnailCache() {
+    // Drop queued decodes, wait for running ones; results they already
+    // posted to the main loop find the cache gone and just free themselves
+    if (m_pool) g_thread_pool_free(m_pool, TRUE, TRUE);
+    *m_alive = false;
+    for (auto& [uuid, slot] : m_slots)
+        if (slot.texture) g_object_unref(slot.texture);
+    for (auto& [uuid, pictures] : m_pending)
+        for (GtkPicture* picture : pictures) g_object_unref(picture);
+}
+
+void ThumbnailCache::show(const std::string& uuid, const std::string& path, GtkPicture* picture) {
+    g_object_set_data_full(G_OBJECT(picture), WANTED_KEY, g_strdup(uuid.c_str()), g_free);
+    gtk_picture_set_paintable(picture, nullptr);
+
+    auto it = m_slots.find(uuid);
+    if (it != m_slots.end()) {
+        m_hits++;
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+        if (it->second.texture) gtk_picture_set_paintable(picture, GDK_PAINTABLE(it->second.texture));
+        return;
+    }
+
+    m_misses++;
+    auto& waiting = m_pending[uuid];
+    for (GtkPicture* p : waiting)
+        if (p == picture) return;  // rebound to the same entry
+    waiting.push_back(static_cast<GtkPicture*>(g_object_ref(picture)));
+    if (waiting.size() > 1) return;  // already being decoded
+    g_thread_pool_push(m_pool, new DecodeJob{uuid, path, m_alive}, nullptr);
+}
+
+void ThumbnailCache::clear(GtkPicture* picture) {
+    g_object_set_data(G_OBJECT(picture), WANTED_KEY, nullptr);
+    gtk_picture_set_paintable(picture, nullptr);
+}
+
+// Worker thread: decode, then hand the texture to the main loop
+void ThumbnailCache::decode(gpointer data, gpointer self) {
+    std::unique_ptr<DecodeJob> job(static_cast<DecodeJob*>(data));
+    // Textures are immutable once created, so any thread may build one
+    GdkTexture* texture = gdk_texture_new_from_filename(job->path.c_str(), nullptr);
+
+    g_main_context_invoke_full(nullptr, G_PRIORITY_DEFAULT,
+        +[](gpointer d) -> gboolean {
+            auto* r = static_cast<DecodeResult*>(d);
+            if (*r->alive) r->cache->finish(r->uuid, std::exchange(r->texture, nullptr));
+            return G_SOURCE_REMOVE;
+        },
+        new DecodeResult{static_cast<ThumbnailCache*>(self), std::move(job->alive),
+                         std::move(job->uuid), texture},
+        +[](gpointer d) { delete static_cast<DecodeResult*>(d); });
+}
+
+void ThumbnailCache::finish(const std::string& uuid, GdkTexture* texture) {
+    m_decodes++;
+    // Failures are cached too (at a token cost), so a broken file isn't retried per row
+    size_t bytes = texture ? static_cast<size_t>(gdk_texture_get_width(texture)) *
+                                 static_cast<size_t>(gdk_texture_get_height(texture)) * 4
+                           : uuid.size();
+    m_lru.push_front(uuid);
+    m_slots[uuid] = {texture, bytes, m_lru.begin()};
+    m_bytes += bytes;
+
+    auto it = m_pending.find(uuid);
+    if (it != m_pending.end()) {
+        for (GtkPicture* picture : it->second) {
+            if (texture && wants(picture, uuid))
+                gtk_picture_set_paintable(picture, GDK_PAINTABLE(texture));
+            g_object_unref(picture);
+        }
+        m_pending.erase(it);
+    }
+    evict();
+}
+
+void ThumbnailCache::evict() {
+    // The newest entry stays even if it alone exceeds the budget
+    while (m_bytes > m_maxBytes && m_lru.size() > 1) {
+        auto it = m_slots.find(m_lru.back());
+        m_bytes -= it->second.bytes;
+        if (it->second.texture) g_object_unref(it->second.texture);
+        m_slots.erase(it);
+        m_lru.pop_back();
+    }
+}
+
+} // namespace hyprclipx
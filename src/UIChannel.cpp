@@ -0,0 +1,228 @@
+// Plugin → UI connection (see UIChannel.hpp)
+// Plugin side - NO GTK: everything runs on Hyprland's event loop
+
+#include "hyprclipx/UIChannel.hpp"
+
+#include <hyprland/src/Compositor.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace hyprclipx {
+
+static constexpr int RETRY_MS = 25;                 // connect attempts while the UI starts
+static constexpr int64_t GIVE_UP_MS = 5000;         // queued commands are stale by then
+static constexpr size_t MAX_QUEUED = 64 * 1024;
+
+static std::string s_socketPath;
+static int s_fd = -1;
+static wl_event_source* s_fdSource = nullptr;
+static wl_event_source* s_retryTimer = nullptr;
+static std::string s_out;           // unsent bytes, whole lines but maybe the first
+static bool s_midLine = false;      // s_out starts inside a line partly sent
+static int64_t s_waitingSince = 0;  // ms; s_out has been waiting for a connection
+static pid_t s_uiPid = -1;          // UI spawned by us
+static int s_uiPidfd = -1;          // readable once it exits
+static wl_event_source* s_uiExitSource = nullptr;
+
+static int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void pump();
+
+// ============================================================================
+// Connection
+// ============================================================================
+
+static void disconnect() {
+    if (s_fdSource) {
+        wl_event_source_remove(s_fdSource);
+        s_fdSource = nullptr;
+    }
+    if (s_fd != -1) {
+        close(s_fd);
+        s_fd = -1;
+    }
+    // The UI saw the start of that line, never its end: don't resend the rest
+    if (s_midLine) {
+        size_t nl = s_out.find('\n');
+        s_out.erase(0, nl == std::string::npos ? s_out.size() : nl + 1);
+        s_midLine = false;
+    }
+}
+
+static int onSocketEvent(int fd, uint32_t mask, void*) {
+    if (mask & WL_EVENT_READABLE) {
+        // The UI never writes on this connection: readable means it closed
+        char buf[64];
+        ssize_t n = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+            mask |= WL_EVENT_HANGUP;
+    }
+    if (mask & (WL_EVENT_HANGUP | WL_EVENT_ERROR)) {
+        disconnect();
+        if (!s_out.empty()) pump();
+        return 0;
+    }
+    if (mask & WL_EVENT_WRITABLE) pump();
+    return 0;
+}
+
+static bool connectUI() {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd == -1) return false;
+
+    struct sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, s_socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    // A local connect completes at once: ENOENT / ECONNREFUSED mean no UI
+    // (yet), EAGAIN a full backlog — all retried the same way
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == -1) {
+        close(fd);
+        return false;
+    }
+    s_fd = fd;
+    s_fdSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, fd, WL_EVENT_READABLE,
+                                      onSocketEvent, nullptr);
+    return true;
+}
+
+// Stops watching the spawned UI (it was reaped, or the plugin unloads)
+static void forgetUI() {
+    if (s_uiExitSource) {
+        wl_event_source_remove(s_uiExitSource);
+        s_uiExitSource = nullptr;
+    }
+    if (s_uiPidfd != -1) {
+        close(s_uiPidfd);
+        s_uiPidfd = -1;
+    }
+    s_uiPid = -1;
+}
+
+// The UI we spawned exited: reap it right away, so it doesn't linger as a
+// zombie child of the compositor until the next spawn
+static int onUIExit(int, uint32_t, void*) {
+    waitpid(s_uiPid, nullptr, WNOHANG);
+    forgetUI();
+    return 0;
+}
+
+// Starts hyprclipx-ui in a session of its own, like the fork+exec it replaces.
+// It creates its socket once initialized; the queued commands follow.
+static void spawnUI() {
+    if (s_uiPid > 0) {
+        if (waitpid(s_uiPid, nullptr, WNOHANG) == 0) return;  // still starting
+        forgetUI();
+    }
+
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSID);
+    char* argv[] = {const_cast<char*>("hyprclipx-ui"), nullptr};
+    pid_t pid;
+    if (posix_spawnp(&pid, "hyprclipx-ui", nullptr, &attr, argv, environ) == 0) s_uiPid = pid;
+    posix_spawnattr_destroy(&attr);
+    if (s_uiPid == -1) return;
+
+    // Without pidfds (Linux < 5.3) it is reaped by the next spawn instead
+    s_uiPidfd = static_cast<int>(syscall(SYS_pidfd_open, s_uiPid, 0));
+    if (s_uiPidfd != -1)
+        s_uiExitSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, s_uiPidfd,
+                                              WL_EVENT_READABLE, onUIExit, nullptr);
+}
+
+// ============================================================================
+// Sending
+// ============================================================================
+
+// Writes what the socket takes; the rest goes when it turns writable
+static void flush() {
+    while (!s_out.empty()) {
+        ssize_t n = send(s_fd, s_out.data(), s_out.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n > 0) {
+            s_midLine = s_out[static_cast<size_t>(n) - 1] != '\n';
+            s_out.erase(0, static_cast<size_t>(n));
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            wl_event_source_fd_update(s_fdSource, WL_EVENT_READABLE | WL_EVENT_WRITABLE);
+            return;
+        }
+        disconnect();  // UI went away
+        return;
+    }
+    wl_event_source_fd_update(s_fdSource, WL_EVENT_READABLE);
+}
+
+static void pump() {
+    if (s_out.empty()) return;
+
+    // The open connection, else a fresh one (also when the open one turns
+    // out to be dead, e.g. the UI was restarted)
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (s_fd == -1 && !connectUI()) break;
+        flush();
+        if (s_fd != -1) {
+            s_waitingSince = 0;
+            return;
+        }
+    }
+
+    // No UI listening: start one and keep trying, within reason
+    if (!s_waitingSince) s_waitingSince = nowMs();
+    if (nowMs() - s_waitingSince > GIVE_UP_MS) {
+        s_out.clear();
+        s_waitingSince = 0;
+        return;
+    }
+    spawnUI();
+    wl_event_source_timer_update(s_retryTimer, RETRY_MS);
+}
+
+static int onRetry(void*) {
+    pump();
+    return 0;
+}
+
+void sendToUI(std::string line) {
+    if (s_socketPath.empty() || s_out.size() + line.size() > MAX_QUEUED) return;
+    s_out += line;
+    pump();
+}
+
+bool startUIChannel(const std::string& socketPath) {
+    stopUIChannel();
+    s_socketPath = socketPath;
+    s_retryTimer = wl_event_loop_add_timer(g_pCompositor->m_wlEventLoop, onRetry, nullptr);
+    // Connect ahead of the first hotkey if the UI is already up
+    connectUI();
+    return s_retryTimer != nullptr;
+}
+
+void stopUIChannel() {
+    disconnect();
+    // Reap it if it already exited; one still running outlives the plugin
+    if (s_uiPid > 0) waitpid(s_uiPid, nullptr, WNOHANG);
+    forgetUI();
+    if (s_retryTimer) {
+        wl_event_source_remove(s_retryTimer);
+        s_retryTimer = nullptr;
+    }
+    s_out.clear();
+    s_midLine = false;
+    s_waitingSince = 0;
+    s_socketPath.clear();
+}
+
+} // namespace hyprclipx
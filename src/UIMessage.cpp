@@ -0,0 +1,31 @@
+// hyprclipx-ui command encoding (see UIMessage.hpp)
+// Shared by the plugin and the UI's CLI - plain C++, no GTK, no Hyprland
+
+#include "hyprclipx/UIMessage.hpp"
+#include "hyprclipx/JsonParser.hpp"
+
+namespace hyprclipx {
+
+std::string encodeUIMessage(const UIMessage& msg) {
+    // cmd is one of a few plain tokens: nothing to escape
+    std::string line = "{\"cmd\":\"" + msg.cmd + "\"";
+    if (msg.since) line += ",\"since\":" + std::to_string(msg.since);
+    if (msg.hasCaret)
+        line += ",\"caret\":[" + std::to_string(msg.caretX) + "," + std::to_string(msg.caretY) + "]";
+    if (msg.hasMonitor)
+        line += ",\"monitor\":[" + std::to_string(msg.monX) + "," + std::to_string(msg.monY) + "," +
+                std::to_string(msg.monW) + "," + std::to_string(msg.monH) + "]";
+    if (msg.hasWindow) {
+        const UIWindow& w = msg.window;
+        line += ",\"window\":{\"address\":\"" + escapeJsonString(w.address) +
+                "\",\"class\":\"" + escapeJsonString(w.windowClass) +
+                "\",\"initialClass\":\"" + escapeJsonString(w.initialClass) +
+                "\",\"title\":\"" + escapeJsonString(w.title) +
+                "\",\"initialTitle\":\"" + escapeJsonString(w.initialTitle) +
+                "\",\"pid\":" + std::to_string(w.pid) +
+                ",\"xwayland\":" + (w.xwayland ? "true" : "false") + "}";
+    }
+    return line + "}\n";
+}
+
+} // namespace hyprclipx
@@ -0,0 +1,239 @@
+// Paste strategy rules and their pattern automaton (see WindowClassifier.hpp)
+
+#include "hyprclipx/WindowClassifier.hpp"
+#include <algorithm>
+#include <fstream>
+
+namespace hyprclipx {
+
+// ── Built-in identifiers (1:1 from AGS) ─────────────────────────────────────
+static const std::vector<std::string> TERMINAL_IDENTIFIERS = {
+    "kitty", "alacritty", "foot", "wezterm", "konsole",
+    "gnome-terminal", "xterm", "urxvt", "terminator", "tilix",
+    "st", "rxvt", "sakura", "terminology", "guake", "tilda",
+    "hyper", "tabby", "contour", "cool-retro-term", "claude"
+};
+
+static const std::vector<std::string> BROWSER_IDENTIFIERS = {
+    "firefox", "chrome", "chromium", "brave", "vivaldi",
+    "opera", "zen", "floorp", "librewolf", "edge"
+};
+
+std::optional<PasteStrategy> parsePasteStrategy(std::string_view name) {
+    if (name == "default") return PasteStrategy::Default;
+    if (name == "terminal") return PasteStrategy::Terminal;
+    if (name == "kitty") return PasteStrategy::Kitty;
+    if (name == "browser") return PasteStrategy::Browser;
+    return std::nullopt;
+}
+
+const char* pasteStrategyName(PasteStrategy strategy) {
+    switch (strategy) {
+        case PasteStrategy::Terminal: return "terminal";
+        case PasteStrategy::Kitty:    return "kitty";
+        case PasteStrategy::Browser:  return "browser";
+        default:                      return "default";
+    }
+}
+
+static unsigned char foldByte(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + 32) : c;
+}
+
+// ============================================================================
+// PatternSet
+// ============================================================================
+
+PatternSet::PatternSet(const std::vector<std::string>& patterns)
+    : m_patterns(patterns.size()), m_words(std::max<size_t>(1, (patterns.size() + 63) / 64)) {
+    // Byte classes: one per (folded) byte some pattern uses, the rest share 0
+    uint8_t classOfFolded[256] = {};
+    for (const auto& p : patterns)
+        for (unsigned char c : p) {
+            unsigned char f = foldByte(c);
+            if (!classOfFolded[f]) classOfFolded[f] = static_cast<uint8_t>(m_classes++);
+        }
+    for (int b = 0; b < 256; b++) m_classOf[b] = classOfFolded[foldByte(static_cast<unsigned char>(b))];
+
+    // Trie
+    auto addState = [&] {
+        m_next.resize(m_next.size() + m_classes, -1);
+        m_out.resize(m_out.size() + m_words, 0);
+        m_hasOut.push_back(0);
+        return static_cast<int32_t>(m_hasOut.size() - 1);
+    };
+    addState();
+    for (size_t i = 0; i < patterns.size(); i++) {
+        int32_t s = 0;
+        for (unsigned char c : patterns[i]) {
+            size_t slot = static_cast<size_t>(s) * m_classes + m_classOf[c];
+            if (m_next[slot] == -1) {
+                int32_t n = addState();
+                m_next[slot] = n;
+            }
+            s = m_next[slot];
+        }
+        m_out[static_cast<size_t>(s) * m_words + i / 64] |= uint64_t{1} << (i % 64);
+        m_hasOut[static_cast<size_t>(s)] = 1;
+    }
+
+    // Failure links, breadth first, folded into the transition table: every
+    // state gets a move on every class, and the outputs of its failure state
+    std::vector<int32_t> fail(m_hasOut.size(), 0);
+    std::vector<int32_t> queue;
+    for (size_t c = 0; c < m_classes; c++) {
+        int32_t& n = m_next[c];
+        if (n == -1) n = 0;
+        else queue.push_back(n);
+    }
+    for (size_t head = 0; head < queue.size(); head++) {
+        int32_t s = queue[head];
+        for (size_t c = 0; c < m_classes; c++) {
+            int32_t& n = m_next[static_cast<size_t>(s) * m_classes + c];
+            int32_t viaFail = m_next[static_cast<size_t>(fail[static_cast<size_t>(s)]) * m_classes + c];
+            if (n == -1) {
+                n = viaFail;
+                continue;
+            }
+            fail[static_cast<size_t>(n)] = viaFail;
+            for (size_t w = 0; w < m_words; w++)
+                m_out[static_cast<size_t>(n) * m_words + w] |= m_out[static_cast<size_t>(viaFail) * m_words + w];
+            m_hasOut[static_cast<size_t>(n)] |= m_hasOut[static_cast<size_t>(viaFail)];
+            queue.push_back(n);
+        }
+    }
+}
+
+void PatternSet::scan(std::string_view text, uint64_t* hits) const {
+    auto step = [&](int32_t s, unsigned char c) {
+        s = m_next[static_cast<size_t>(s) * m_classes + m_classOf[c]];
+        if (m_hasOut[static_cast<size_t>(s)]) {
+            const uint64_t* out = &m_out[static_cast<size_t>(s) * m_words];
+            for (size_t w = 0; w < m_words; w++) hits[w] |= out[w];
+        }
+        return s;
+    };
+    int32_t s = step(0, static_cast<unsigned char>(ANCHOR_START));
+    for (char c : text) s = step(s, static_cast<unsigned char>(c));
+    step(s, static_cast<unsigned char>(ANCHOR_END));
+}
+
+// ============================================================================
+// WindowClassifier
+// ============================================================================
+
+// "^kitty$" → ANCHOR_START "kitty" ANCHOR_END
+static std::string compilePattern(std::string_view p) {
+    std::string out;
+    if (!p.empty() && p.front() == '^') {
+        out += PatternSet::ANCHOR_START;
+        p.remove_prefix(1);
+    }
+    bool anchorEnd = !p.empty() && p.back() == '$';
+    if (anchorEnd) p.remove_suffix(1);
+    for (char c : p) out += static_cast<char>(foldByte(static_cast<unsigned char>(c)));
+    if (anchorEnd) out += PatternSet::ANCHOR_END;
+    return out;
+}
+
+// /proc/<pid>/comm, without its newline
+static std::string processName(int pid) {
+    std::ifstream f("/proc/" + std::to_string(pid) + "/comm");
+    std::string comm;
+    std::getline(f, comm);
+    return comm;
+}
+
+WindowClassifier::WindowClassifier(const std::vector<PasteRule>& userRules) {
+    static constexpr uint8_t CLASS = (1 << Class) | (1 << InitialClass);
+    static constexpr uint8_t TITLE = (1 << Title) | (1 << InitialTitle);
+    static constexpr uint8_t COMM  = 1 << Comm;
+
+    for (const auto& r : userRules) {
+        auto strategy = parsePasteStrategy(r.paste);
+        if (!strategy) continue;
+        std::vector<std::pair<uint8_t, std::vector<std::string>>> conditions;
+        if (!r.classes.empty()) conditions.emplace_back(CLASS, r.classes);
+        if (!r.titles.empty()) conditions.emplace_back(TITLE, r.titles);
+        if (!r.comms.empty()) conditions.emplace_back(COMM, r.comms);
+        if (!r.any.empty()) conditions.emplace_back(CLASS | TITLE | COMM, r.any);
+        addRule(std::move(conditions), r.xwayland, *strategy);
+    }
+
+    // Built-in, in the order sendPasteKeys used to test them
+    addRule({{1 << InitialTitle, {"^kitty$"}}}, -1, PasteStrategy::Kitty);
+    addRule({{COMM, {"^kitty$"}}}, -1, PasteStrategy::Kitty);
+    addRule({{CLASS | TITLE | COMM, TERMINAL_IDENTIFIERS}}, -1, PasteStrategy::Terminal);
+    addRule({{1 << Class, BROWSER_IDENTIFIERS}}, -1, PasteStrategy::Browser);
+
+    m_patterns.emplace(m_patternList);
+}
+
+void WindowClassifier::addRule(std::vector<std::pair<uint8_t, std::vector<std::string>>> conditions,
+                               int xwayland, PasteStrategy strategy) {
+    Rule rule;
+    rule.xwayland = xwayland;
+    rule.strategy = strategy;
+    for (auto& [fields, patterns] : conditions) {
+        Condition c{fields, {}};
+        for (const auto& p : patterns) {
+            std::string compiled = compilePattern(p);
+            if (compiled.empty()) continue;
+            auto [it, added] = m_patternIds.emplace(compiled, static_cast<uint32_t>(m_patternList.size()));
+            if (added) m_patternList.push_back(compiled);
+            c.patterns.push_back(it->second);
+        }
+        if (c.patterns.empty()) return;  // nothing it could match: drop the rule
+        if (fields & (1 << Comm)) m_needsComm = true;
+        rule.conditions.push_back(std::move(c));
+    }
+    m_rules.push_back(std::move(rule));
+}
+
+bool WindowClassifier::hit(const std::vector<uint64_t>& hits, Field field, uint32_t pattern) const {
+    return (hits[field * m_patterns->words() + pattern / 64] >> (pattern % 64)) & 1;
+}
+
+PasteStrategy WindowClassifier::classify(const UIWindow& win) {
+    const size_t words = m_patterns->words();
+    auto row = [&](std::vector<uint64_t>& hits, Field f) { return hits.data() + f * words; };
+
+    // Class and process name don't change while the client runs
+    std::string key = win.windowClass + '\0' + std::to_string(win.pid);
+    std::vector<uint64_t> hits;
+    {
+        std::lock_guard lock(m_cacheMutex);
+        auto it = m_cache.find(key);
+        if (it != m_cache.end()) hits = it->second;
+    }
+    if (hits.empty()) {
+        hits.assign(FIELD_COUNT * words, 0);
+        m_patterns->scan(win.windowClass, row(hits, Class));
+        if (m_needsComm && win.pid > 0) m_patterns->scan(processName(win.pid), row(hits, Comm));
+        std::lock_guard lock(m_cacheMutex);
+        if (m_cache.size() >= MAX_CACHED) m_cache.clear();
+        m_cache.emplace(key, hits);
+    }
+    m_patterns->scan(win.initialClass, row(hits, InitialClass));
+    m_patterns->scan(win.title, row(hits, Title));
+    m_patterns->scan(win.initialTitle, row(hits, InitialTitle));
+
+    for (const auto& rule : m_rules) {
+        if (rule.xwayland != -1 && rule.xwayland != static_cast<int>(win.xwayland)) continue;
+        bool all = std::all_of(rule.conditions.begin(), rule.conditions.end(), [&](const Condition& c) {
+            for (uint32_t p : c.patterns)
+                for (int f = 0; f < FIELD_COUNT; f++)
+                    if ((c.fields & (1 << f)) && hit(hits, static_cast<Field>(f), p)) return true;
+            return false;
+        });
+        if (all) return rule.strategy;
+    }
+    return PasteStrategy::Default;
+}
+
+size_t WindowClassifier::cached() const {
+    std::lock_guard lock(m_cacheMutex);
+    return m_cache.size();
+}
+
+} // namespace hyprclipx
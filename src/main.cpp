@@ -1,5 +1,5 @@
 // HyprClipX - Layer-shell clipboard manager for Hyprland
-// Plugin entry point - LIGHTWEIGHT (no GTK, no threads)
+// Plugin entry point - LIGHTWEIGHT (no GTK; one worker thread for caret lookups)
 // UI runs as separate process (hyprclipx-ui)
 
 #define WLR_USE_UNSTABLE
@@ -5,6 +5,8 @@
 #include "hyprclipx/ClipboardRenderer.hpp"
 #include "hyprclipx/ClipboardManager.hpp"
 #include "hyprclipx/ConfigParser.hpp"
+#include "hyprclipx/JsonParser.hpp"
+#include "hyprclipx/UIMessage.hpp"
 #include <gtk/gtk.h>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -12,70 +14,116 @@
 #include <csignal>
 #include <cstdlib>
 #include <cstring>
+#include <cstdio>
 #include <string>
+#include <string_view>
 
 using namespace hyprclipx;
 
-static const char* SOCKET_PATH = "/tmp/hyprclipx-ui.sock";
+static std::string g_socketPath;
 static ClipboardRenderer* g_renderer = nullptr;
 static int g_listenSock = -1;
 
 // ============================================================================
 // Send command to existing UI instance (returns true if sent)
+// With `reply`, waits for the instance's answer (until it closes the socket)
 // ============================================================================
 
-static bool sendCommand(const char* cmd) {
+static bool sendCommand(const UIMessage& msg, std::string* reply = nullptr) {
     int sock = socket(AF_UNIX, SOCK_STREAM, 0);
     if (sock == -1) return false;
 
     struct sockaddr_un addr{};
     addr.sun_family = AF_UNIX;
-    strncpy(addr.sun_path, SOCKET_PATH, sizeof(addr.sun_path) - 1);
+    strncpy(addr.sun_path, g_socketPath.c_str(), sizeof(addr.sun_path) - 1);
 
     if (connect(sock, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == -1) {
         close(sock);
         return false;
     }
 
-    ssize_t written = write(sock, cmd, strlen(cmd));
+    std::string line = encodeUIMessage(msg);
+    ssize_t written = write(sock, line.data(), line.size());
+    if (written > 0 && reply) {
+        shutdown(sock, SHUT_WR);
+        char buf[4096];
+        ssize_t n;
+        while ((n = read(sock, buf, sizeof(buf))) > 0)
+            reply->append(buf, static_cast<size_t>(n));
+    }
     close(sock);
     return written > 0;
 }
 
 // ============================================================================
-// Socket listener (accepts commands from plugin via fork+exec)
+// Socket listener: the plugin keeps one connection open and writes a
+// UIMessage line per hotkey; the CLI sends one line and closes
 // ============================================================================
 
-static gboolean onSocketAccept(GIOChannel*, GIOCondition, gpointer) {
-    struct sockaddr_un clientAddr{};
-    socklen_t clientLen = sizeof(clientAddr);
-    int clientSock = accept(g_listenSock,
-        reinterpret_cast<struct sockaddr*>(&clientAddr), &clientLen);
-    if (clientSock == -1) return TRUE;
-
-    char buf[64] = {};
-    ssize_t n = read(clientSock, buf, sizeof(buf) - 1);
-    close(clientSock);
+static constexpr size_t MAX_LINE = 16 * 1024;  // the plugin caps window strings at 256 bytes
+
+struct Client {
+    int fd;
+    std::string buf;  // received, not yet a whole line
+};
+
+static void handleMessage(const Client& client, std::string_view line) {
+    UIMessage msg;
+    if (!g_renderer || !parseUIMessage(line, msg)) return;
+    if (msg.cmd == "toggle") g_renderer->toggle(msg);
+    else if (msg.cmd == "show") g_renderer->show(msg);
+    else if (msg.cmd == "hide") g_renderer->hide();
+    else if (msg.cmd == "stats") {
+        std::string reply = g_renderer->stats() + "\n";
+        send(client.fd, reply.data(), reply.size(), MSG_NOSIGNAL);
+    }
+}
 
-    if (n > 0 && g_renderer) {
-        std::string cmd(buf, static_cast<size_t>(n));
-        if (cmd == "toggle") g_renderer->toggle();
-        else if (cmd == "show") g_renderer->show();
-        else if (cmd == "hide") g_renderer->hide();
+static gboolean onClientReadable(GIOChannel*, GIOCondition, gpointer data) {
+    auto* client = static_cast<Client*>(data);
+    char buf[4096];
+    ssize_t n = read(client->fd, buf, sizeof(buf));
+    if (n > 0) {
+        client->buf.append(buf, static_cast<size_t>(n));
+        size_t start = 0, nl;
+        while ((nl = client->buf.find('\n', start)) != std::string::npos) {
+            handleMessage(*client, std::string_view(client->buf).substr(start, nl - start));
+            start = nl + 1;
+        }
+        client->buf.erase(0, start);
+        return client->buf.size() <= MAX_LINE;  // not talking our protocol: drop it
     }
+    // Closed: a last line may come without its newline
+    if (!client->buf.empty()) handleMessage(*client, client->buf);
+    return FALSE;
+}
+
+static gboolean onSocketAccept(GIOChannel*, GIOCondition, gpointer) {
+    int clientSock = accept4(g_listenSock, nullptr, nullptr, SOCK_CLOEXEC);
+    if (clientSock == -1) return TRUE;
 
+    GIOChannel* channel = g_io_channel_unix_new(clientSock);
+    g_io_add_watch_full(channel, G_PRIORITY_DEFAULT,
+                        static_cast<GIOCondition>(G_IO_IN | G_IO_HUP | G_IO_ERR),
+                        onClientReadable, new Client{clientSock, {}},
+                        +[](gpointer data) {
+                            auto* client = static_cast<Client*>(data);
+                            close(client->fd);
+                            delete client;
+                        });
+    g_io_channel_unref(channel);
     return TRUE;
 }
 
 static bool createSocketListener() {
-    unlink(SOCKET_PATH);
+    unlink(g_socketPath.c_str());
 
-    g_listenSock = socket(AF_UNIX, SOCK_STREAM, 0);
+    g_listenSock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
     if (g_listenSock == -1) return false;
 
     struct sockaddr_un addr{};
     addr.sun_family = AF_UNIX;
-    strncpy(addr.sun_path, SOCKET_PATH, sizeof(addr.sun_path) - 1);
+    strncpy(addr.sun_path, g_socketPath.c_str(), sizeof(addr.sun_path) - 1);
 
     if (bind(g_listenSock, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == -1) {
         close(g_listenSock);
@@ -107,6 +155,9 @@ static void onSignal(int) {
 // ============================================================================
 
 int main(int argc, char* argv[]) {
+    // Hotkey → first frame latency counts from here for CLI shows
+    gint64 requestedAt = g_get_monotonic_time();
+
     // Parse command
     std::string cmd;
     for (int i = 1; i < argc; i++) {
@@ -114,11 +165,30 @@ int main(int argc, char* argv[]) {
         if (arg == "--toggle" || arg == "toggle") cmd = "toggle";
         else if (arg == "--show" || arg == "show") cmd = "show";
         else if (arg == "--hide" || arg == "hide") cmd = "hide";
+        else if (arg == "--stats" || arg == "stats") cmd = "stats";
+    }
+
+    Config config = loadConfig();
+    g_socketPath = config.uiSocket;
+
+    UIMessage msg;
+    msg.cmd = cmd;
+    if (cmd == "toggle" || cmd == "show") msg.since = requestedAt;
+
+    // Stats only make sense for a running instance
+    if (cmd == "stats") {
+        std::string reply;
+        if (!sendCommand(msg, &reply)) {
+            fprintf(stderr, "hyprclipx-ui: no running instance\n");
+            return 1;
+        }
+        fputs(reply.c_str(), stdout);
+        return 0;
     }
 
     // If we have a command, try sending to existing instance first
     if (!cmd.empty()) {
-        if (sendCommand(cmd.c_str())) {
+        if (sendCommand(msg)) {
             return 0;  // Sent to running instance, done
         }
         // No running instance → start one and execute command
@@ -127,8 +197,7 @@ int main(int argc, char* argv[]) {
     // Initialize GTK (safe: we're a separate Wayland client, NOT inside compositor)
     gtk_init();
 
-    // Load config
-    Config config = loadConfig();
+    // Paths
     const char* homeEnv = getenv("HOME");
     std::string home = homeEnv ? homeEnv : "/root";
     config.clipmanClient = home + "/.local/bin/clipman-client.py";
@@ -149,7 +218,7 @@ int main(int argc, char* argv[]) {
     // If started with a command, execute it now
     if (!cmd.empty()) {
         if (cmd == "toggle" || cmd == "show") {
-            renderer.show();
+            renderer.show(msg);
         }
     }
 
@@ -164,7 +233,7 @@ int main(int argc, char* argv[]) {
 
     // Cleanup
     g_renderer = nullptr;
-    unlink(SOCKET_PATH);
+    unlink(g_socketPath.c_str());
     if (g_listenSock >= 0) close(g_listenSock);
 
     return 0;